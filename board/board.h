@@ -8,11 +8,13 @@
 #pragma once
 
 #include "hole.h"
+#include "zobrist.h"
 
 #include <array>
 
 #include <cstdbool>
 #include <cstdint>
+#include <cstdio>
 
 namespace Mancala
 {
@@ -57,11 +59,17 @@ namespace Mancala
         */
 
         public:
+            /**
+             * The number of marbles in each hole at the start.
+             */
+            static const uint8_t start_marbles = N;
+
             /**
              * The board constructor.
              */
             Board() : a_home(), b_home()
             {
+                rehash();
             }
 
             /**
@@ -107,6 +115,23 @@ namespace Mancala
 
                 a_home.reset();
                 b_home.reset();
+
+                rehash();
+            }
+
+            /**
+             * Getter for the Zobrist key of the board.
+             *
+             * @note The key is kept up to date as marbles are moved, and
+             *       matches BoardState::key for the same position.
+             *
+             * @param side The side to move.
+             *
+             * @return The key of the position with the side to move.
+             */
+            uint64_t get_key(const Side side) const
+            {
+                return key ^ Zobrist::side_to_move(side == Side::B);
             }
 
             /**
@@ -175,6 +200,8 @@ namespace Mancala
                     case Side::A:
                         if (row < 6)
                         {
+                            key ^= Zobrist::pit_delta(index(side, row),
+                                holes[0][row].get(), n_marbles);
                             holes[0][row].set(n_marbles);
                         }
                         break;
@@ -182,6 +209,8 @@ namespace Mancala
                     case Side::B:
                         if (row < 6)
                         {
+                            key ^= Zobrist::pit_delta(index(side, row),
+                                holes[1][row].get(), n_marbles);
                             holes[1][row].set(n_marbles);
                         }
                         break;
@@ -206,10 +235,14 @@ namespace Mancala
                 switch(side)
                 {
                     case Side::A:
+                        key ^= Zobrist::pit_delta(index(side, row),
+                            holes[0][row].get(), holes[0][row].get() + n_marbles);
                         holes[0][row].add(n_marbles);
                         break;
 
                     case Side::B:
+                        key ^= Zobrist::pit_delta(index(side, row),
+                            holes[1][row].get(), holes[1][row].get() + n_marbles);
                         holes[1][row].add(n_marbles);
                         break;
 
@@ -230,10 +263,14 @@ namespace Mancala
                 switch(side)
                 {
                     case Side::A:
+                        key ^= Zobrist::pit_delta(home_index(side),
+                            a_home.get(), a_home.get() + n_marbles);
                         a_home.add(n_marbles);
                         break;
 
                     case Side::B:
+                        key ^= Zobrist::pit_delta(home_index(side),
+                            b_home.get(), b_home.get() + n_marbles);
                         b_home.add(n_marbles);
                         break;
 
@@ -250,7 +287,7 @@ namespace Mancala
              *
              * @return The home count.
              */
-            uint8_t get_home(const Side side)
+            uint8_t get_home(const Side side) const
             {
                 switch(side)
                 {
@@ -265,10 +302,83 @@ namespace Mancala
                     default:
                         break;
                 }
-            }     
+
+                return 0;
+            }
+
+            /**
+             * Set the marble count of the home spot of the side specified.
+             *
+             * @param side The side of the board to specify Side::A, or
+             *        Side::B.
+             * @param n_marbles The number of marbles to set the home with.
+             */
+            void set_home(const Side side,
+                const uint8_t n_marbles)
+            {
+                switch(side)
+                {
+                    case Side::A:
+                        key ^= Zobrist::pit_delta(home_index(side),
+                            a_home.get(), n_marbles);
+                        a_home.set(n_marbles);
+                        break;
+
+                    case Side::B:
+                        key ^= Zobrist::pit_delta(home_index(side),
+                            b_home.get(), n_marbles);
+                        b_home.set(n_marbles);
+                        break;
+
+                    default:
+                        break;
+                }
+            }
 
         private:
 
+            /**
+             * Flat index of a hole, as laid out in Figure 2 of
+             * board_state.h.
+             *
+             * @param side The side of the board.
+             * @param row The row on the board.
+             *
+             * @return The flat index of the hole.
+             */
+            static uint8_t index(const Side side, const uint8_t row)
+            {
+                return side == Side::A ? row : static_cast<uint8_t>(12u - row);
+            }
+
+            /**
+             * Flat index of a home, as laid out in Figure 2 of
+             * board_state.h.
+             *
+             * @param side The side of the board.
+             *
+             * @return The flat index of the home.
+             */
+            static uint8_t home_index(const Side side)
+            {
+                return side == Side::A ? 6u : 13u;
+            }
+
+            /**
+             * Recompute the key from scratch.
+             */
+            void rehash()
+            {
+                key = Zobrist::pit_key(home_index(Side::A), a_home.get()) ^
+                    Zobrist::pit_key(home_index(Side::B), b_home.get());
+
+                for (uint8_t row = 0; row < 6; row++)
+                {
+                    key ^= Zobrist::pit_key(index(Side::A, row), holes[0][row].get());
+                    key ^= Zobrist::pit_key(index(Side::B, row), holes[1][row].get());
+                }
+            }
+
             /**
              * The internal data structure to keep track of the holes on the
              * board.
@@ -286,5 +396,10 @@ namespace Mancala
             /**
              * @}
              */
+
+            /**
+             * The Zobrist key of the pits, without the side to move.
+             */
+            uint64_t key;
     };
 }
\ No newline at end of file
@@ -0,0 +1,272 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Header file for a packed, flat Mancala board state.
+ */
+
+#pragma once
+
+#include "board.h"
+#include "move_set.h"
+#include "zobrist.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Mancala
+{
+    /**
+     * A flat, trivially-copyable snapshot of a Mancala board.
+     *
+     * All 14 pits are stored in one contiguous array, in the order that
+     * marbles are sown (counterclockwise in Figure 1 of board.h):
+     *
+     *        index:  0  1  2  3  4  5    6     7  8  9 10 11 12    13
+     *         pit : A0 A1 A2 A3 A4 A5 Home A  B5 B4 B3 B2 B1 B0 Home B
+     *
+     *                Figure 2. Flat board layout.
+     *
+     * The opposite of pit i (i < 13, i != 6) is pit 12 - i, and a side's
+     * pits can be addressed without branching on the side. The state is
+     * padded to 16 bytes so that it can be moved with one vector load and
+     * store.
+     *
+     * @note The padding bytes are always zero so that states can be
+     *       compared and hashed as 16 raw bytes.
+     */
+    struct alignas(16) BoardState
+    {
+        /**
+         * The total number of pits, including both homes.
+         */
+        static constexpr uint8_t n_pits = 14u;
+
+        /**
+         * The number of rows on each side of the board.
+         */
+        static constexpr uint8_t n_rows = 6u;
+
+        /**
+         * Index of the home pit of the side specified.
+         *
+         * @param side The side of the board.
+         *
+         * @return The flat index of the home pit.
+         */
+        static constexpr uint8_t home(const Side side)
+        {
+            return side == Side::A ? 6u : 13u;
+        }
+
+        /**
+         * Index of the pit at a row of the side specified.
+         *
+         * @param side The side of the board.
+         * @param row The row on the board (0 to 5).
+         *
+         * @return The flat index of the pit.
+         */
+        static constexpr uint8_t pit(const Side side, const uint8_t row)
+        {
+            return side == Side::A ? row : static_cast<uint8_t>(12u - row);
+        }
+
+        /**
+         * Index of the pit across the board from a non-home pit.
+         *
+         * @param index The flat index of a non-home pit.
+         *
+         * @return The flat index of the opposite pit.
+         */
+        static constexpr uint8_t opposite(const uint8_t index)
+        {
+            return static_cast<uint8_t>(12u - index);
+        }
+
+        /**
+         * Build the starting state for a board.
+         *
+         * @param n_marbles The number of marbles in each non-home pit.
+         *
+         * @return The starting state.
+         */
+        static BoardState initial(const uint8_t n_marbles = 4u)
+        {
+            BoardState state;
+            memset(&state, 0, sizeof(state));
+
+            for (uint8_t row = 0; row < n_rows; row++)
+            {
+                state.pits[pit(Side::A, row)] = n_marbles;
+                state.pits[pit(Side::B, row)] = n_marbles;
+            }
+
+            return state;
+        }
+
+        /**
+         * Convert a board to its flat state.
+         *
+         * @param board The board to convert.
+         *
+         * @return The flat state of the board.
+         */
+        template <uint8_t N>
+        static BoardState from_board(const Board<N> &board)
+        {
+            BoardState state;
+            memset(&state, 0, sizeof(state));
+
+            for (uint8_t row = 0; row < n_rows; row++)
+            {
+                state.pits[pit(Side::A, row)] = board.get_hole(Side::A, row);
+                state.pits[pit(Side::B, row)] = board.get_hole(Side::B, row);
+            }
+
+            state.pits[home(Side::A)] = board.get_home(Side::A);
+            state.pits[home(Side::B)] = board.get_home(Side::B);
+
+            return state;
+        }
+
+        /**
+         * Write this state back onto a board.
+         *
+         * @param[out] board The board to overwrite.
+         */
+        template <uint8_t N>
+        void to_board(Board<N> &board) const
+        {
+            for (uint8_t row = 0; row < n_rows; row++)
+            {
+                board.set_hole(Side::A, row, pits[pit(Side::A, row)]);
+                board.set_hole(Side::B, row, pits[pit(Side::B, row)]);
+            }
+
+            board.set_home(Side::A, pits[home(Side::A)]);
+            board.set_home(Side::B, pits[home(Side::B)]);
+        }
+
+        /**
+         * Getter for the number of marbles in a hole.
+         *
+         * @param side The side of the board.
+         * @param row The row on the board (0 to 5).
+         *
+         * @return The number of marbles in the hole.
+         */
+        uint8_t get_hole(const Side side, const uint8_t row) const
+        {
+            return pits[pit(side, row)];
+        }
+
+        /**
+         * Getter for the number of marbles in a home.
+         *
+         * @param side The side of the board.
+         *
+         * @return The number of marbles in the home.
+         */
+        uint8_t get_home(const Side side) const
+        {
+            return pits[home(side)];
+        }
+
+        /**
+         * Get the rows a side can play: the non-empty holes on its side.
+         *
+         * @param side The side to move.
+         *
+         * @return The playable rows.
+         */
+        MoveSet legal_moves(const Side side) const
+        {
+#if defined(__SSE2__)
+            /*
+             * One bit per non-empty pit, in the order of Figure 2.
+             */
+            const __m128i counts = _mm_load_si128(reinterpret_cast<const __m128i *>(pits));
+            const unsigned filled = ~static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(counts, _mm_setzero_si128())));
+
+            if (side == Side::A)
+            {
+                return MoveSet(static_cast<uint8_t>(filled));
+            }
+
+            /*
+             * B's pits run from row 5 to row 0, so its bits are reversed.
+             */
+            static const uint8_t reversed[64] =
+            {
+                 0, 32, 16, 48,  8, 40, 24, 56,  4, 36, 20, 52, 12, 44, 28, 60,
+                 2, 34, 18, 50, 10, 42, 26, 58,  6, 38, 22, 54, 14, 46, 30, 62,
+                 1, 33, 17, 49,  9, 41, 25, 57,  5, 37, 21, 53, 13, 45, 29, 61,
+                 3, 35, 19, 51, 11, 43, 27, 59,  7, 39, 23, 55, 15, 47, 31, 63
+            };
+
+            return MoveSet(reversed[(filled >> 7) & 0x3Fu]);
+#else
+            uint8_t mask = 0;
+
+            for (uint8_t row = 0; row < n_rows; row++)
+            {
+                mask |= static_cast<uint8_t>((pits[pit(side, row)] != 0) << row);
+            }
+
+            return MoveSet(mask);
+#endif
+        }
+
+        /**
+         * Compute the Zobrist key of the position.
+         *
+         * @param side The side to move.
+         *
+         * @return The key, equal to Board::get_key for the same position.
+         */
+        uint64_t key(const Side side) const
+        {
+            uint64_t hash = Zobrist::side_to_move(side == Side::B);
+
+            for (uint8_t index = 0; index < n_pits; index++)
+            {
+                hash ^= Zobrist::pit_key(index, pits[index]);
+            }
+
+            return hash;
+        }
+
+        bool operator==(const BoardState &other) const
+        {
+            return memcmp(this, &other, sizeof(BoardState)) == 0;
+        }
+
+        bool operator!=(const BoardState &other) const
+        {
+            return !(*this == other);
+        }
+
+        /**
+         * The marble counts, laid out as in Figure 2.
+         */
+        uint8_t pits[n_pits];
+
+        /**
+         * Zero padding up to 16 bytes.
+         */
+        uint8_t padding[16u - n_pits];
+    };
+
+    static_assert(sizeof(BoardState) == 16u,
+        "BoardState must fit in one 16 byte vector");
+    static_assert(std::is_trivially_copyable<BoardState>::value,
+        "BoardState must be trivially copyable");
+}
@@ -0,0 +1,131 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Header file for a set of playable rows.
+ */
+
+#pragma once
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A set of rows on one side of the board, one bit per row (bit 0 is
+     * row 0).
+     *
+     * Iterating a MoveSet yields its rows in increasing order:
+     *
+     *     for (uint8_t row : state.legal_moves(side)) { ... }
+     */
+    class MoveSet
+    {
+        public:
+            /**
+             * Iterator over the rows in a set.
+             */
+            class iterator
+            {
+                public:
+                    explicit iterator(const uint8_t _bits) : bits(_bits)
+                    {
+                    }
+
+                    uint8_t operator*() const
+                    {
+                        return static_cast<uint8_t>(__builtin_ctz(bits));
+                    }
+
+                    iterator &operator++()
+                    {
+                        bits &= static_cast<uint8_t>(bits - 1u);
+                        return *this;
+                    }
+
+                    bool operator!=(const iterator &other) const
+                    {
+                        return bits != other.bits;
+                    }
+
+                    bool operator==(const iterator &other) const
+                    {
+                        return bits == other.bits;
+                    }
+
+                private:
+                    /**
+                     * The rows not yet visited.
+                     */
+                    uint8_t bits;
+            };
+
+            /**
+             * The constructor.
+             *
+             * @param _mask One bit per row in the set.
+             */
+            explicit MoveSet(const uint8_t _mask = 0u) : bits(_mask & 0x3Fu)
+            {
+            }
+
+            /**
+             * Get the set as a mask.
+             *
+             * @return One bit per row in the set.
+             */
+            uint8_t mask() const
+            {
+                return bits;
+            }
+
+            /**
+             * Check if a row is in the set.
+             *
+             * @param row The row to check.
+             *
+             * @return True if the row is in the set.
+             */
+            bool contains(const uint8_t row) const
+            {
+                return row < 8u && (bits >> row) & 1u;
+            }
+
+            /**
+             * Check if the set has no rows.
+             *
+             * @return True if there are no rows in the set.
+             */
+            bool empty() const
+            {
+                return bits == 0u;
+            }
+
+            /**
+             * Get the number of rows in the set.
+             *
+             * @return The number of rows.
+             */
+            uint8_t size() const
+            {
+                return static_cast<uint8_t>(__builtin_popcount(bits));
+            }
+
+            iterator begin() const
+            {
+                return iterator(bits);
+            }
+
+            iterator end() const
+            {
+                return iterator(0u);
+            }
+
+        private:
+            /**
+             * One bit per row.
+             */
+            uint8_t bits;
+    };
+}
@@ -0,0 +1,71 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The Zobrist keys used to hash Mancala positions.
+ */
+
+#include "zobrist.h"
+
+#include <cstdint>
+
+namespace Mancala
+{
+    namespace Zobrist
+    {
+        /**
+         * The seed of the key generator. Changing it invalidates every
+         * stored key.
+         */
+        static const uint64_t seed = 0x6d616e63616c61ull;
+
+        /**
+         * Step a splitmix64 generator.
+         *
+         * @param state The generator state.
+         *
+         * @return The next random number.
+         */
+        static uint64_t splitmix64(uint64_t &state)
+        {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * The counts keyed when the table stopped at 96 marbles. Their keys
+         * and the side key are drawn first, in the order they always were,
+         * so that keys stored in files since then still match.
+         */
+        static const uint8_t first_counts = 96u;
+
+        Keys generate()
+        {
+            Keys generated;
+            uint64_t state = seed;
+
+            for (uint8_t index = 0; index < n_pits; index++)
+            {
+                for (uint16_t count = 0; count <= first_counts; count++)
+                {
+                    generated.pit[index][count] = splitmix64(state);
+                }
+            }
+
+            generated.side = splitmix64(state);
+
+            for (uint8_t index = 0; index < n_pits; index++)
+            {
+                for (uint16_t count = first_counts + 1u; count <= max_marbles; count++)
+                {
+                    generated.pit[index][count] = splitmix64(state);
+                }
+            }
+
+            return generated;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Header file for the Zobrist keys used to hash Mancala positions.
+ */
+
+#pragma once
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * Random keys for hashing a position.
+     *
+     * A position's key is the XOR of one key per pit, picked by the pit's
+     * flat index (Figure 2 of board_state.h) and its marble count, XORed
+     * with side_key when B is to move. Changing a pit from one count to
+     * another is a pair of XORs, so boards can keep their keys up to date
+     * as marbles move.
+     */
+    namespace Zobrist
+    {
+        /**
+         * The total number of pits, including both homes.
+         */
+        static const uint8_t n_pits = 14u;
+
+        /**
+         * The most marbles a pit can hold and still be hashed: every count
+         * its byte can hold, so no board can index past the keys.
+         */
+        static const uint8_t max_marbles = 255u;
+
+        /**
+         * The key table.
+         */
+        struct Keys
+        {
+            /**
+             * The key of each count of each pit.
+             */
+            uint64_t pit[n_pits][max_marbles + 1u];
+
+            /**
+             * The key XORed in when B is to move.
+             */
+            uint64_t side;
+        };
+
+        /**
+         * Fill in the key table from a fixed seed, so that keys are the
+         * same from run to run (and can be stored in files).
+         *
+         * @return The keys.
+         */
+        Keys generate();
+
+        /**
+         * Get the keys, filled in on first use so that boards can be
+         * hashed from static initializers in any translation unit.
+         *
+         * @return The keys.
+         */
+        inline const Keys &get_keys()
+        {
+            static const Keys keys = generate();
+
+            return keys;
+        }
+
+        /**
+         * Get the key of a pit holding a number of marbles.
+         *
+         * @param index The flat index of the pit.
+         * @param n_marbles The number of marbles in the pit.
+         *
+         * @return The pit's key.
+         */
+        inline uint64_t pit_key(const uint8_t index, const uint8_t n_marbles)
+        {
+            return get_keys().pit[index][n_marbles];
+        }
+
+        /**
+         * Get the change to a key when a pit's count changes.
+         *
+         * @param index The flat index of the pit.
+         * @param from The number of marbles in the pit before.
+         * @param to The number of marbles in the pit after.
+         *
+         * @return The value to XOR into the key.
+         */
+        inline uint64_t pit_delta(const uint8_t index, const uint8_t from,
+            const uint8_t to)
+        {
+            return get_keys().pit[index][from] ^ get_keys().pit[index][to];
+        }
+
+        /**
+         * Get the key of the side to move.
+         *
+         * @param b_to_move True if B is to move.
+         *
+         * @return The value to XOR into the key.
+         */
+        inline uint64_t side_to_move(const bool b_to_move)
+        {
+            return b_to_move ? get_keys().side : 0u;
+        }
+    }
+}
@@ -0,0 +1,391 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Batched move application for many independent boards.
+ */
+
+#include "batch.h"
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * The loops over boards are written to be vectorized by the compiler.
+ * On x86 they are built for both AVX2 and the baseline, and the loader
+ * picks the best one the CPU supports.
+ */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define BATCH_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define BATCH_KERNEL
+#endif
+
+namespace Mancala
+{
+    /**
+     * The number of pits a marble can land in during a move: every pit
+     * except the opponent's home.
+     */
+    static const uint8_t lap_length = BoardState::n_pits - 1u;
+
+    /**
+     * Boards are padded to a multiple of this many so that each row of
+     * pits starts on a vector boundary.
+     */
+    static const size_t lane_block = 32u;
+
+    /**
+     * Boards are played this many at a time, so that the scratch rows
+     * and the slice of each row of pits being worked on stay in L1.
+     */
+    static const size_t block_size = 512u;
+
+    /**
+     * The position of each pit in the order it is sown, for each mover.
+     * The opponent's home is skipped and gets 0xFF.
+     * @{
+     */
+    static const uint8_t a_position[BoardState::n_pits] =
+    {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0xFF
+    };
+    static const uint8_t b_position[BoardState::n_pits] =
+    {
+        0, 1, 2, 3, 4, 5, 0xFF, 6, 7, 8, 9, 10, 11, 12
+    };
+    /**
+     * @}
+     */
+
+    /**
+     * Pick up each board's start pit and work out where its last marble
+     * will land. A board whose move is invalid sows nothing, and is
+     * marked with a start pit of 0xFF.
+     */
+    BATCH_KERNEL
+    static void pick_up(const uint8_t *pits, const size_t stride, const size_t count,
+        const Side *__restrict sides,
+        const uint8_t *__restrict rows,
+        uint8_t *__restrict mover_a,
+        uint8_t *__restrict start_pit,
+        uint8_t *__restrict start_position,
+        uint8_t *__restrict laps,
+        uint8_t *__restrict remainder,
+        uint8_t *__restrict last_pit)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint8_t row = rows[i] < BoardState::n_rows ? rows[i] : 0u;
+
+            mover_a[i] = sides[i] == Side::A ? 0xFF : 0x00;
+            start_pit[i] = mover_a[i] ? row : static_cast<uint8_t>(12u - row);
+            laps[i] = 0;
+        }
+
+        /*
+         * Select each board's start pit out of the rows of pits, rather
+         * than gathering it, so that the loop stays vectorized.
+         */
+        for (uint8_t k = 0; k < BoardState::n_pits; k++)
+        {
+            const uint8_t *__restrict row = pits + k * stride;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                laps[i] |= row[i] & (start_pit[i] == k ? 0xFF : 0x00);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const bool valid = rows[i] < BoardState::n_rows && laps[i] != 0;
+            const uint8_t marbles = valid ? laps[i] : 0u;
+
+            start_pit[i] = valid ? start_pit[i] : 0xFF;
+            start_position[i] = mover_a[i] ? start_pit[i] : static_cast<uint8_t>(start_pit[i] - 1u);
+            laps[i] = marbles / lap_length;
+            remainder[i] = marbles % lap_length;
+
+            uint8_t last = start_position[i] + remainder[i];
+            last -= last >= lap_length ? lap_length : 0u;
+            last += !mover_a[i] && last >= BoardState::n_rows ? 1u : 0u;
+
+            last_pit[i] = valid ? last : 0xFF;
+        }
+    }
+
+    /**
+     * Sow every board: clear the start pit, then add the whole laps and
+     * the leftover marbles, one row of pits at a time. Also picks out the
+     * counts of the pit each board's last marble landed in, and of the
+     * pit across from it.
+     */
+    BATCH_KERNEL
+    static void sow_pits(uint8_t *pits, const size_t stride, const size_t count,
+        const uint8_t *__restrict mover_a,
+        const uint8_t *__restrict start_pit,
+        const uint8_t *__restrict start_position,
+        const uint8_t *__restrict laps,
+        const uint8_t *__restrict remainder,
+        const uint8_t *__restrict last_pit,
+        uint8_t *__restrict last_count,
+        uint8_t *__restrict across_count)
+    {
+        memset(last_count, 0, count);
+        memset(across_count, 0, count);
+
+        for (uint8_t k = 0; k < BoardState::n_pits; k++)
+        {
+            uint8_t *__restrict row = pits + k * stride;
+
+            const uint8_t a_eligible = a_position[k] == 0xFF ? 0x00 : 0xFF;
+            const uint8_t b_eligible = b_position[k] == 0xFF ? 0x00 : 0xFF;
+            const uint8_t across = BoardState::opposite(k);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint8_t eligible = (mover_a[i] & a_eligible) |
+                    (~mover_a[i] & b_eligible);
+                const uint8_t position = (mover_a[i] & a_position[k]) |
+                    (~mover_a[i] & b_position[k]);
+
+                /*
+                 * How far past the start this pit is: 0 for the start,
+                 * 1 to 12 for the pits after it.
+                 */
+                uint8_t distance = position - start_position[i];
+                distance += distance >= lap_length ? lap_length : 0u;
+
+                const uint8_t tail = static_cast<uint8_t>(distance - 1u) < remainder[i] ? 1u : 0u;
+                const uint8_t keep = start_pit[i] == k ? 0x00 : 0xFF;
+                const uint8_t marbles = (row[i] & keep) + ((laps[i] + tail) & eligible);
+
+                row[i] = marbles;
+                last_count[i] |= marbles & (last_pit[i] == k ? 0xFF : 0x00);
+                across_count[i] |= marbles & (last_pit[i] == across ? 0xFF : 0x00);
+            }
+        }
+    }
+
+    /**
+     * Apply each board's capture, and set each move's result from where
+     * its last marble landed.
+     *
+     * @param[in,out] capture The count of each board's last pit on the
+     *                way in, 0xFF for each board with a capture on the
+     *                way out.
+     */
+    BATCH_KERNEL
+    static void capture_pits(uint8_t *pits, const size_t stride, const size_t count,
+        const uint8_t *__restrict mover_a,
+        const uint8_t *__restrict last_pit,
+        uint8_t *__restrict capture,
+        const uint8_t *__restrict across_count,
+        int8_t *__restrict results)
+    {
+        const uint8_t a_home_pit = BoardState::home(Side::A);
+        const uint8_t b_home_pit = BoardState::home(Side::B);
+
+        uint8_t *__restrict a_home = pits + a_home_pit * stride;
+        uint8_t *__restrict b_home = pits + b_home_pit * stride;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint8_t last = last_pit[i];
+
+            /*
+             * The last marble landed in an empty hole on the mover's side.
+             */
+            const bool own = mover_a[i] ? last < a_home_pit :
+                (last > a_home_pit && last < b_home_pit);
+            const uint8_t captured = own && capture[i] == 1 ? 0xFF : 0x00;
+            const uint8_t stolen = (across_count[i] + 1u) & captured;
+
+            a_home[i] += stolen & mover_a[i];
+            b_home[i] += stolen & ~mover_a[i];
+            capture[i] = captured;
+
+            const bool in_home = last == (mover_a[i] ? a_home_pit : b_home_pit);
+            const bool a_next = (mover_a[i] != 0) == in_home;
+
+            results[i] = last == 0xFF ?
+                static_cast<int8_t>(GameState::EmptyHoleError) :
+                static_cast<int8_t>(a_next ? GameState::SideA : GameState::SideB);
+        }
+
+        for (uint8_t k = 0; k < BoardState::n_pits; k++)
+        {
+            uint8_t *__restrict row = pits + k * stride;
+            const uint8_t across = BoardState::opposite(k);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint8_t taken = last_pit[i] == k || last_pit[i] == across ? 0xFF : 0x00;
+
+                row[i] &= ~(taken & capture[i]);
+            }
+        }
+    }
+
+    /**
+     * Find the finished boards, sweep the marbles left on them into their
+     * owners' homes, and mark their results as GameOver.
+     */
+    BATCH_KERNEL
+    static void sweep_pits(uint8_t *pits, const size_t stride, const size_t count,
+        const uint8_t *__restrict start_pit,
+        uint8_t *__restrict sweep_a,
+        uint8_t *__restrict sweep_b,
+        int8_t *__restrict results)
+    {
+        memset(sweep_a, 0, count);
+        memset(sweep_b, 0, count);
+
+        /*
+         * OR up each side's rows: A0..A5 are pits 0 to 5 and B5..B0 are
+         * pits 7 to 12.
+         */
+        for (uint8_t k = 0; k < BoardState::n_rows; k++)
+        {
+            const uint8_t *__restrict a_row = pits + k * stride;
+            const uint8_t *__restrict b_row = pits + (k + 7u) * stride;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                sweep_a[i] |= a_row[i];
+                sweep_b[i] |= b_row[i];
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint8_t a_empty = sweep_a[i] == 0 ? 0xFF : 0x00;
+            const uint8_t b_empty = sweep_b[i] == 0 ? 0xFF : 0x00;
+            const uint8_t over = (a_empty | b_empty) & (start_pit[i] == 0xFF ? 0x00 : 0xFF);
+
+            /*
+             * The side that still has marbles keeps them. When both sides
+             * are empty this sweeps nothing.
+             */
+            sweep_a[i] = over & b_empty;
+            sweep_b[i] = over & ~b_empty;
+
+            results[i] = over ? static_cast<int8_t>(GameState::GameOver) : results[i];
+        }
+
+        uint8_t *__restrict a_home = pits + BoardState::home(Side::A) * stride;
+        uint8_t *__restrict b_home = pits + BoardState::home(Side::B) * stride;
+
+        for (uint8_t k = 0; k < BoardState::n_rows; k++)
+        {
+            uint8_t *__restrict a_row = pits + k * stride;
+            uint8_t *__restrict b_row = pits + (k + 7u) * stride;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                a_home[i] += a_row[i] & sweep_a[i];
+                a_row[i] &= ~sweep_a[i];
+
+                b_home[i] += b_row[i] & sweep_b[i];
+                b_row[i] &= ~sweep_b[i];
+            }
+        }
+    }
+
+    BoardBatch::BoardBatch(size_t size) :
+        count(0),
+        stride(0)
+    {
+        resize(size);
+    }
+
+    void BoardBatch::resize(size_t size)
+    {
+        count = size;
+        stride = (size + lane_block - 1u) / lane_block * lane_block;
+
+        pits.assign(BoardState::n_pits * stride, 0u);
+        scratch.assign(Scratch::n_scratch * block_size, 0u);
+    }
+
+    size_t BoardBatch::size() const
+    {
+        return count;
+    }
+
+    void BoardBatch::set(size_t index, const BoardState &state)
+    {
+        for (uint8_t k = 0; k < BoardState::n_pits; k++)
+        {
+            pits[k * stride + index] = state.pits[k];
+        }
+    }
+
+    BoardState BoardBatch::get(size_t index) const
+    {
+        BoardState state;
+        memset(&state, 0, sizeof(state));
+
+        for (uint8_t k = 0; k < BoardState::n_pits; k++)
+        {
+            state.pits[k] = pits[k * stride + index];
+        }
+
+        return state;
+    }
+
+    uint8_t *BoardBatch::pit(uint8_t pit)
+    {
+        return &pits[pit * stride];
+    }
+
+    const uint8_t *BoardBatch::pit(uint8_t pit) const
+    {
+        return &pits[pit * stride];
+    }
+
+    uint8_t *BoardBatch::scratch_row(Scratch value)
+    {
+        return &scratch[value * block_size];
+    }
+
+    void BoardBatch::apply_moves(const Side *sides, const uint8_t *rows,
+        GameState *results)
+    {
+        uint8_t *mover = scratch_row(Scratch::mover_a);
+        uint8_t *start = scratch_row(Scratch::start_pit);
+        uint8_t *position = scratch_row(Scratch::start_position);
+        uint8_t *laps = scratch_row(Scratch::laps);
+        uint8_t *remainder = scratch_row(Scratch::remainder);
+        uint8_t *last = scratch_row(Scratch::last_pit);
+        uint8_t *last_count = scratch_row(Scratch::last_count);
+        uint8_t *across_count = scratch_row(Scratch::across_count);
+        uint8_t *sweep_a = scratch_row(Scratch::sweep_a);
+        uint8_t *sweep_b = scratch_row(Scratch::sweep_b);
+
+        /*
+         * GameState is a one byte enum, so results are written as bytes.
+         */
+        int8_t *result_bytes = reinterpret_cast<int8_t *>(results);
+
+        for (size_t base = 0; base < count; base += block_size)
+        {
+            const size_t n = count - base < block_size ? count - base : block_size;
+            uint8_t *block = pits.data() + base;
+
+            pick_up(block, stride, n, sides + base, rows + base,
+                mover, start, position, laps, remainder, last);
+
+            sow_pits(block, stride, n,
+                mover, start, position, laps, remainder, last, last_count, across_count);
+
+            capture_pits(block, stride, n,
+                mover, last, last_count, across_count, result_bytes + base);
+
+            sweep_pits(block, stride, n, start, sweep_a, sweep_b, result_bytes + base);
+        }
+    }
+}
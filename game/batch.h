@@ -0,0 +1,146 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Batched move application for many independent boards.
+ */
+
+#pragma once
+
+#include "board_state.h"
+#include "game_state.h"
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mancala
+{
+    /**
+     * A batch of independent boards stored structure-of-arrays: pit k of
+     * every board is contiguous, so one move per board can be applied to
+     * the whole batch with vector instructions.
+     *
+     * Pits are indexed as in Figure 2 of board_state.h.
+     */
+    class BoardBatch
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param size The number of boards in the batch. Every board
+         *        starts empty.
+         */
+        explicit BoardBatch(size_t size = 0);
+
+        /**
+         * Change the number of boards in the batch.
+         *
+         * @note Existing boards are not preserved.
+         *
+         * @param size The number of boards.
+         */
+        void resize(size_t size);
+
+        /**
+         * Get the number of boards in the batch.
+         *
+         * @return The number of boards.
+         */
+        size_t size() const;
+
+        /**
+         * Copy a board into the batch.
+         *
+         * @param index The board to overwrite.
+         * @param state The board to copy in.
+         */
+        void set(size_t index, const BoardState &state);
+
+        /**
+         * Copy a board out of the batch.
+         *
+         * @param index The board to read.
+         *
+         * @return The board's state.
+         */
+        BoardState get(size_t index) const;
+
+        /**
+         * Get the counts of one pit across every board.
+         *
+         * @param pit The pit index (see Figure 2 in board_state.h).
+         *
+         * @return size() counts, one per board.
+         * @{
+         */
+        uint8_t *pit(uint8_t pit);
+        const uint8_t *pit(uint8_t pit) const;
+        /**
+         * @}
+         */
+
+        /**
+         * Play one move on every board.
+         *
+         * Each board follows the same rules as apply_move in sowing.h,
+         * and a board whose move is invalid is left untouched.
+         *
+         * @param[in] sides The side moving on each board.
+         * @param[in] rows The row to sow from on each board.
+         * @param[out] results The result of each move: SideA or SideB for
+         *             the side to move next, GameOver, or EmptyHoleError.
+         */
+        void apply_moves(const Side *sides, const uint8_t *rows,
+            GameState *results);
+
+    private:
+        /**
+         * Per board scratch values used while applying moves, one row
+         * for each block of boards played at a time.
+         */
+        typedef enum : uint8_t
+        {
+            mover_a = 0,
+            start_pit,
+            start_position,
+            laps,
+            remainder,
+            last_pit,
+            last_count,
+            across_count,
+            sweep_a,
+            sweep_b,
+            n_scratch
+        } Scratch;
+
+        /**
+         * Get the scratch row for a value.
+         */
+        uint8_t *scratch_row(Scratch value);
+
+        /**
+         * The number of boards.
+         */
+        size_t count;
+
+        /**
+         * The distance between the rows of pits, rounded up so that every
+         * row starts on a vector boundary.
+         */
+        size_t stride;
+
+        /**
+         * The pit counts: pit k of board i is at pits[k * stride + i].
+         */
+        std::vector<uint8_t> pits;
+
+        /**
+         * Scratch rows for apply_moves.
+         */
+        std::vector<uint8_t> scratch;
+    };
+}
@@ -0,0 +1,697 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An endgame database of exact values for positions with few
+ *        marbles left in the holes.
+ */
+
+#include "endgame_db.h"
+#include "sowing.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Packed endgame segments are read as little endian words"
+#endif
+
+namespace Mancala
+{
+    /**
+     * The value of a position not solved yet.
+     */
+    static const int8_t unsolved = -128;
+
+    /**
+     * The number of holes on the board.
+     */
+    static const uint8_t n_holes = 12u;
+
+    /**
+     * The file header.
+     */
+    struct EndgameHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t max_marbles;
+        uint64_t n_positions;
+        uint32_t block_positions;
+        uint32_t reserved;
+    };
+
+    /**
+     * How a segment's values are stored.
+     */
+    typedef enum : uint32_t
+    {
+        Raw = 0,
+        Packed = 1
+    } SegmentEncoding;
+
+    /**
+     * Where the positions of one marble count are stored.
+     */
+    struct EndgameSegment
+    {
+        uint64_t first;
+        uint64_t n_positions;
+        uint64_t offset;
+        uint32_t n_blocks;
+        SegmentEncoding encoding;
+    };
+
+    static const char endgame_magic[8] = {'M', 'N', 'C', 'L', 'E', 'G', 'D', 'B'};
+    static const uint32_t endgame_version = 2u;
+
+    /**
+     * The number of positions in a packed block.
+     */
+    static const uint32_t block_positions = 4096u;
+
+    /**
+     * Segments start on a page boundary.
+     */
+    static const uint64_t segment_alignment = 4096u;
+
+    /**
+     * A packed block: its smallest stored number, the bits per position,
+     * then the positions. The bits are read 8 bytes at a time, so every
+     * packed segment ends with 8 bytes of padding.
+     */
+    static const uint8_t block_header = 2u;
+    static const uint8_t block_padding = 8u;
+
+    /**
+     * Binomial coefficients C(n, k) for every n and k used in ranking.
+     */
+    struct Binomials
+    {
+        uint64_t c[EndgameDatabase::max_marbles + n_holes + 1u][n_holes + 1u];
+    };
+
+    static Binomials make_binomials()
+    {
+        Binomials table;
+        memset(&table, 0, sizeof(table));
+
+        for (uint8_t n = 0; n <= EndgameDatabase::max_marbles + n_holes; n++)
+        {
+            table.c[n][0] = 1u;
+
+            for (uint8_t k = 1; k <= n_holes && k <= n; k++)
+            {
+                table.c[n][k] = table.c[n - 1u][k - 1u] + (k < n ? table.c[n - 1u][k] : 0u);
+            }
+        }
+
+        return table;
+    }
+
+    /**
+     * Get the binomial coefficients, built on first use so that positions
+     * can be ranked from static initializers in any translation unit.
+     */
+    static const Binomials &binomials()
+    {
+        static const Binomials table = make_binomials();
+
+        return table;
+    }
+
+    /**
+     * Get the holes of a position in the order ranked: the side to move's
+     * first.
+     */
+    static inline uint8_t read_holes(const BoardState &state, const Side side,
+        uint8_t holes[n_holes])
+    {
+        /*
+         * Turning the board around is a rotation of Figure 2 by 7 pits.
+         */
+        const uint8_t shift = side == Side::A ? 0u : 7u;
+        uint8_t total = 0;
+
+        for (uint8_t i = 0; i < BoardState::n_rows; i++)
+        {
+            holes[i] = state.pits[(i + shift) % BoardState::n_pits];
+            holes[i + BoardState::n_rows] = state.pits[(i + 7u + shift) % BoardState::n_pits];
+            total = static_cast<uint8_t>(total + holes[i] + holes[i + BoardState::n_rows]);
+        }
+
+        return total;
+    }
+
+    /**
+     * Build a position with A to move and empty homes from its holes.
+     */
+    static inline BoardState from_holes(const uint8_t holes[n_holes])
+    {
+        BoardState state = BoardState::initial(0u);
+
+        for (uint8_t i = 0; i < BoardState::n_rows; i++)
+        {
+            state.pits[i] = holes[i];
+            state.pits[i + 7u] = holes[i + BoardState::n_rows];
+        }
+
+        return state;
+    }
+
+    /**
+     * Get the number stored for a value with n marbles in the holes.
+     */
+    static inline uint8_t halve(const int8_t value, const uint8_t n_marbles)
+    {
+        return static_cast<uint8_t>((value + n_marbles) / 2);
+    }
+
+    /**
+     * Get the bits needed to store the numbers 0 to range.
+     */
+    static inline uint8_t bits_for(const uint8_t range)
+    {
+        uint8_t bits = 0;
+
+        while ((1u << bits) <= range)
+        {
+            bits++;
+        }
+
+        return bits;
+    }
+
+    /**
+     * Write zeros up to a file offset.
+     */
+    static bool pad_to(FILE *file, const uint64_t offset)
+    {
+        long position = ftell(file);
+
+        while (position >= 0 && static_cast<uint64_t>(position) < offset)
+        {
+            if (fputc(0, file) == EOF)
+            {
+                return false;
+            }
+
+            position++;
+        }
+
+        return position >= 0;
+    }
+
+    /**
+     * Pack one segment's values.
+     *
+     * @param values The segment's values.
+     * @param n_positions The number of values.
+     * @param n_marbles The segment's marble count.
+     * @param[out] packed The packed segment: block offsets, then blocks.
+     */
+    static void pack_segment(const int8_t *values, const uint64_t n_positions,
+        const uint8_t n_marbles, std::vector<uint8_t> &packed)
+    {
+        const uint64_t n_blocks = (n_positions + block_positions - 1u) / block_positions;
+
+        packed.assign(n_blocks * sizeof(uint64_t), 0u);
+
+        for (uint64_t block = 0; block < n_blocks; block++)
+        {
+            const uint64_t begin = block * block_positions;
+            const uint64_t end = begin + block_positions < n_positions ?
+                begin + block_positions : n_positions;
+
+            uint8_t low = 0xFF;
+            uint8_t high = 0;
+
+            for (uint64_t i = begin; i < end; i++)
+            {
+                const uint8_t number = halve(values[i], n_marbles);
+                low = number < low ? number : low;
+                high = number > high ? number : high;
+            }
+
+            const uint8_t bits = bits_for(static_cast<uint8_t>(high - low));
+            const uint64_t offset = packed.size();
+
+            memcpy(&packed[block * sizeof(uint64_t)], &offset, sizeof(offset));
+
+            packed.push_back(low);
+            packed.push_back(bits);
+            packed.resize(packed.size() + ((end - begin) * bits + 7u) / 8u, 0u);
+
+            uint8_t *data = &packed[offset + block_header];
+
+            for (uint64_t i = begin; i < end; i++)
+            {
+                const uint64_t bit = (i - begin) * bits;
+                const uint32_t number = halve(values[i], n_marbles) - low;
+
+                data[bit / 8u] = static_cast<uint8_t>(data[bit / 8u] | number << (bit % 8u));
+
+                if (bit % 8u + bits > 8u)
+                {
+                    data[bit / 8u + 1u] = static_cast<uint8_t>(data[bit / 8u + 1u] | number >> (8u - bit % 8u));
+                }
+            }
+        }
+
+        packed.resize(packed.size() + block_padding, 0u);
+    }
+
+    /**
+     * Check a packed segment's blocks lie within the file, so that probes
+     * into them cannot read past its end.
+     *
+     * @param mapping The mapped file.
+     * @param size The file's size.
+     * @param segment The segment, with its offset checked to be in the file.
+     *
+     * @return True if every block, with the padding read after it, is in
+     *         the file and packs at most 8 bits a position.
+     */
+    static bool valid_blocks(const uint8_t *mapping, const size_t size,
+        const EndgameSegment &segment)
+    {
+        const uint64_t room = size - segment.offset;
+
+        if (segment.n_blocks != (segment.n_positions + block_positions - 1u) / block_positions ||
+            segment.n_blocks * sizeof(uint64_t) > room)
+        {
+            return false;
+        }
+
+        const uint8_t *data = mapping + segment.offset;
+
+        for (uint64_t block = 0; block < segment.n_blocks; block++)
+        {
+            uint64_t offset;
+            memcpy(&offset, data + block * sizeof(uint64_t), sizeof(offset));
+
+            if (offset > room || room - offset < block_header)
+            {
+                return false;
+            }
+
+            const uint64_t begin = block * block_positions;
+            const uint64_t count = segment.n_positions - begin < block_positions ?
+                segment.n_positions - begin : block_positions;
+            const uint8_t bits = data[offset + 1u];
+
+            if (bits > 8u ||
+                room - offset - block_header < (count * bits + 7u) / 8u + block_padding)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    EndgameDatabase::EndgameDatabase() :
+        mapping(NULL),
+        mapping_size(0),
+        covered(-1)
+    {
+    }
+
+    EndgameDatabase::~EndgameDatabase()
+    {
+        unmap();
+    }
+
+    void EndgameDatabase::unmap()
+    {
+        if (mapping != NULL)
+        {
+            munmap(const_cast<uint8_t *>(mapping), mapping_size);
+            mapping = NULL;
+            mapping_size = 0;
+        }
+    }
+
+    uint64_t EndgameDatabase::positions(uint8_t n_marbles)
+    {
+        return binomials().c[n_marbles + n_holes][n_holes];
+    }
+
+    uint64_t EndgameDatabase::rank(const uint8_t holes[12])
+    {
+        const Binomials &table = binomials();
+        uint64_t index = 0;
+        uint8_t bar = 0;
+
+        for (uint8_t i = 0; i + 1u < n_holes; i++)
+        {
+            bar = static_cast<uint8_t>(bar + holes[i]);
+            index += table.c[bar][i + 1u];
+            bar++;
+        }
+
+        /*
+         * bar is now n + 11, so the positions with fewer marbles number
+         * C(n + 11, 12).
+         */
+        return table.c[bar + holes[n_holes - 1u]][n_holes] + index;
+    }
+
+    int8_t EndgameDatabase::solve(const BoardState &state)
+    {
+        uint8_t holes[n_holes];
+        read_holes(state, Side::A, holes);
+
+        int8_t &value = values[rank(holes)];
+
+        if (value != unsolved)
+        {
+            return value;
+        }
+
+        int16_t own = 0;
+        int16_t other = 0;
+
+        for (uint8_t i = 0; i < BoardState::n_rows; i++)
+        {
+            own += holes[i];
+            other += holes[i + BoardState::n_rows];
+        }
+
+        /*
+         * A position with an empty side is over: each side sweeps its own
+         * holes.
+         */
+        if (own == 0 || other == 0)
+        {
+            value = static_cast<int8_t>(own - other);
+            return value;
+        }
+
+        int16_t best = unsolved;
+
+        for (uint8_t row : state.legal_moves(Side::A))
+        {
+            BoardState child = state;
+            const GameState result = apply_move(child, Side::A, row);
+
+            int16_t score = static_cast<int16_t>(child.get_home(Side::A)) -
+                static_cast<int16_t>(child.get_home(Side::B));
+
+            if (result != GameState::GameOver)
+            {
+                child.pits[BoardState::home(Side::A)] = 0;
+                child.pits[BoardState::home(Side::B)] = 0;
+
+                if (result == GameState::SideA)
+                {
+                    score += solve(child);
+                }
+                else
+                {
+                    uint8_t turned[n_holes];
+                    read_holes(child, Side::B, turned);
+
+                    score -= solve(from_holes(turned));
+                }
+            }
+
+            if (score > best)
+            {
+                best = score;
+            }
+        }
+
+        value = static_cast<int8_t>(best);
+
+        return value;
+    }
+
+    bool EndgameDatabase::generate(uint8_t n_marbles)
+    {
+        if (n_marbles > max_marbles)
+        {
+            return false;
+        }
+
+        unmap();
+        values.assign(positions(n_marbles), unsolved);
+        covered = -1;
+
+        for (uint8_t layer = 0; layer <= n_marbles; layer++)
+        {
+            /*
+             * Step through every way to put the layer's marbles in the 12
+             * holes.
+             */
+            uint8_t holes[n_holes] = {0};
+            holes[0] = layer;
+
+            while (true)
+            {
+                solve(from_holes(holes));
+
+                uint8_t i = 0;
+
+                while (i + 1u < n_holes && holes[i] == 0)
+                {
+                    i++;
+                }
+
+                if (i + 1u == n_holes)
+                {
+                    break;
+                }
+
+                const uint8_t moved = holes[i];
+                holes[i] = 0;
+                holes[0] = static_cast<uint8_t>(moved - 1u);
+                holes[i + 1u]++;
+            }
+
+            covered = layer;
+        }
+
+        return true;
+    }
+
+    bool EndgameDatabase::save(const char *path, bool packed) const
+    {
+        if (covered < 0 || mapping != NULL)
+        {
+            return false;
+        }
+
+        const uint8_t n_segments = static_cast<uint8_t>(covered + 1);
+
+        EndgameHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, endgame_magic, sizeof(header.magic));
+        header.version = endgame_version;
+        header.max_marbles = static_cast<uint32_t>(covered);
+        header.n_positions = values.size();
+        header.block_positions = block_positions;
+
+        /*
+         * Pack every segment up front, to lay the file out.
+         */
+        std::vector<EndgameSegment> segments(n_segments);
+        std::vector<std::vector<uint8_t> > contents(n_segments);
+        uint64_t offset = sizeof(header) + n_segments * sizeof(EndgameSegment);
+
+        for (uint8_t n = 0; n < n_segments; n++)
+        {
+            EndgameSegment &segment = segments[n];
+            segment.first = n == 0 ? 0u : positions(static_cast<uint8_t>(n - 1u));
+            segment.n_positions = positions(n) - segment.first;
+            segment.n_blocks = static_cast<uint32_t>(
+                (segment.n_positions + block_positions - 1u) / block_positions);
+            segment.encoding = SegmentEncoding::Raw;
+
+            if (packed)
+            {
+                pack_segment(&values[segment.first], segment.n_positions, n, contents[n]);
+
+                if (contents[n].size() < segment.n_positions)
+                {
+                    segment.encoding = SegmentEncoding::Packed;
+                }
+                else
+                {
+                    contents[n].clear();
+                }
+            }
+
+            offset = (offset + segment_alignment - 1u) / segment_alignment * segment_alignment;
+            segment.offset = offset;
+            offset += segment.encoding == SegmentEncoding::Packed ?
+                contents[n].size() : segment.n_positions;
+        }
+
+        FILE *file = fopen(path, "wb");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(segments.data(), sizeof(EndgameSegment), n_segments, file) == n_segments;
+
+        for (uint8_t n = 0; n < n_segments && written; n++)
+        {
+            const EndgameSegment &segment = segments[n];
+
+            written = pad_to(file, segment.offset) &&
+                (segment.encoding == SegmentEncoding::Packed ?
+                fwrite(contents[n].data(), 1, contents[n].size(), file) == contents[n].size() :
+                fwrite(&values[segment.first], 1, segment.n_positions, file) == segment.n_positions);
+        }
+
+        return fclose(file) == 0 && written;
+    }
+
+    bool EndgameDatabase::load(const char *path)
+    {
+        unmap();
+        values.clear();
+        covered = -1;
+
+        const int fd = open(path, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(EndgameHeader))
+        {
+            close(fd);
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(status.st_size);
+        void *memory = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+        /*
+         * The mapping holds its own reference to the file.
+         */
+        close(fd);
+
+        if (memory == MAP_FAILED)
+        {
+            return false;
+        }
+
+        mapping = static_cast<const uint8_t *>(memory);
+        mapping_size = size;
+
+        const EndgameHeader *header = reinterpret_cast<const EndgameHeader *>(mapping);
+        const EndgameSegment *segments =
+            reinterpret_cast<const EndgameSegment *>(mapping + sizeof(EndgameHeader));
+
+        bool valid = memcmp(header->magic, endgame_magic, sizeof(header->magic)) == 0 &&
+            header->version == endgame_version &&
+            header->max_marbles <= max_marbles &&
+            header->block_positions == block_positions &&
+            header->n_positions == positions(static_cast<uint8_t>(header->max_marbles)) &&
+            sizeof(EndgameHeader) + (header->max_marbles + 1u) * sizeof(EndgameSegment) <= size;
+
+        for (uint32_t n = 0; valid && n <= header->max_marbles; n++)
+        {
+            const EndgameSegment &segment = segments[n];
+
+            valid = segment.first == (n == 0 ? 0u : positions(static_cast<uint8_t>(n - 1u))) &&
+                segment.n_positions == positions(static_cast<uint8_t>(n)) - segment.first &&
+                segment.offset <= size &&
+                (segment.encoding == SegmentEncoding::Packed ?
+                valid_blocks(mapping, size, segment) :
+                segment.encoding == SegmentEncoding::Raw &&
+                segment.offset + segment.n_positions <= size);
+        }
+
+        if (!valid)
+        {
+            unmap();
+            return false;
+        }
+
+        /*
+         * Probes land anywhere in the segments, so read-ahead would only
+         * waste memory, while the header and segment table are needed at
+         * once.
+         */
+        madvise(memory, size, MADV_RANDOM);
+        madvise(memory, segments[0].offset, MADV_WILLNEED);
+
+        covered = static_cast<int16_t>(header->max_marbles);
+
+        return true;
+    }
+
+    bool EndgameDatabase::probe(const BoardState &state, Side side, int16_t &value) const
+    {
+        uint8_t holes[n_holes];
+        const uint8_t n_marbles = read_holes(state, side, holes);
+
+        if (n_marbles > covered)
+        {
+            return false;
+        }
+
+        const uint64_t index = rank(holes);
+
+        if (mapping == NULL)
+        {
+            value = values[index];
+            return true;
+        }
+
+        const EndgameSegment &segment = reinterpret_cast<const EndgameSegment *>(
+            mapping + sizeof(EndgameHeader))[n_marbles];
+        const uint8_t *data = mapping + segment.offset;
+        const uint64_t position = index - segment.first;
+
+        if (segment.encoding == SegmentEncoding::Raw)
+        {
+            value = static_cast<int8_t>(data[position]);
+            return true;
+        }
+
+        uint64_t offset;
+        memcpy(&offset, data + position / block_positions * sizeof(uint64_t), sizeof(offset));
+
+        const uint8_t *block = data + offset;
+        const uint8_t bits = block[1];
+        const uint64_t bit = (position % block_positions) * bits;
+
+        uint64_t word;
+        memcpy(&word, block + block_header + bit / 8u, sizeof(word));
+
+        const uint8_t number = static_cast<uint8_t>(
+            block[0] + ((word >> (bit % 8u)) & ((1u << bits) - 1u)));
+
+        value = static_cast<int16_t>(2 * number - n_marbles);
+
+        return true;
+    }
+
+    int16_t EndgameDatabase::get_max_marbles() const
+    {
+        return covered;
+    }
+
+    size_t EndgameDatabase::size() const
+    {
+        return covered < 0 ? 0u : positions(static_cast<uint8_t>(covered));
+    }
+}
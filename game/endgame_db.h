@@ -0,0 +1,207 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An endgame database of exact values for positions with few
+ *        marbles left in the holes.
+ */
+
+#pragma once
+
+#include "board_state.h"
+
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * The exact value of every position with at most a set number of
+     * marbles left in the 12 holes.
+     *
+     * How the rest of a game goes does not depend on the homes, so a
+     * position is stored by its holes alone, and its value is what the
+     * side to move will gain from here on: the marbles it will still add
+     * to its home, less the marbles the other side will still add. The
+     * final difference between the homes is the current difference plus
+     * the value. A position with B to move is stored as the same position
+     * turned around, with A to move (B's holes in A's place and the other
+     * way around), which plays the same.
+     *
+     * The positions with n marbles in the holes are ranked by the
+     * combinatorial number system: the 12 counts are read as 11 bars among
+     * n + 11 places, and the bar places b0 < b1 < ... < b10 give the index
+     *
+     *     C(b0, 1) + C(b1, 2) + ... + C(b10, 11)
+     *
+     * in [0, C(n + 11, 11)). All positions with fewer marbles come first,
+     * C(n + 11, 12) of them, so every position has its own slot and no
+     * keys are stored.
+     *
+     * Marbles only ever leave the holes, and a move that leaves the same
+     * number of marbles in the holes moves them all closer to its side's
+     * home. The positions of each marble count are then solved from the
+     * counts below, with no cycles to resolve.
+     *
+     * Databases are stored to be mapped into memory read-only, so that a
+     * database of any size is ready as soon as it is opened and its pages
+     * are shared by every process using it. After a header, the file holds
+     * one segment per marble count, each starting on a page:
+     *
+     *     header  : magic, version, marble count, positions, block size
+     *     segments: for each marble count, its first index, its number of
+     *               positions, its offset in the file and its encoding
+     *     segment : the values, in one of two encodings:
+     *
+     *         raw   : one signed byte per position.
+     *         packed: all n marbles end in one home or the other, so a
+     *                 value always has the parity of n, and (value + n) / 2
+     *                 is stored instead. Each block of positions stores its
+     *                 smallest such number and the bits needed above it,
+     *                 then each position in that many bits. A table of
+     *                 block offsets starts the segment.
+     *
+     * Any value can be read straight from the mapping in either encoding,
+     * so nothing is ever decompressed to probe.
+     */
+    class EndgameDatabase
+    {
+
+    public:
+        /**
+         * The most marbles in the holes a database can be built for.
+         */
+        static const uint8_t max_marbles = 32u;
+
+        /**
+         * Constructor for an empty database.
+         */
+        EndgameDatabase();
+
+        /**
+         * Destructor.
+         */
+        ~EndgameDatabase();
+
+        /**
+         * Solve every position with up to a number of marbles in the
+         * holes.
+         *
+         * @param n_marbles The most marbles in the holes to solve for.
+         *
+         * @return True on success, false if n_marbles is too large.
+         */
+        bool generate(uint8_t n_marbles);
+
+        /**
+         * Write a generated database to a file.
+         *
+         * @param path The file to write.
+         * @param packed True to pack the values, false to store a byte per
+         *        position. A segment that packing would not shrink is
+         *        stored raw regardless.
+         *
+         * @return True on success.
+         */
+        bool save(const char *path, bool packed = true) const;
+
+        /**
+         * Map a database file into memory. Pages are read in from the file
+         * as positions are probed.
+         *
+         * @param path The file to map.
+         *
+         * @return True on success.
+         */
+        bool load(const char *path);
+
+        /**
+         * Look up the value of a position.
+         *
+         * @param state The position.
+         * @param side The side to move.
+         * @param[out] value The marbles the side to move will gain over the
+         *        other side from here on, with best play by both.
+         *
+         * @return True if the position is in the database.
+         */
+        bool probe(const BoardState &state, Side side, int16_t &value) const;
+
+        /**
+         * Get the most marbles in the holes covered.
+         *
+         * @return The marble count, or -1 if the database is empty.
+         */
+        int16_t get_max_marbles() const;
+
+        /**
+         * Get the number of positions stored.
+         *
+         * @return The number of positions.
+         */
+        size_t size() const;
+
+        /**
+         * Get the number of positions with up to a number of marbles in
+         * the holes.
+         *
+         * @param n_marbles The most marbles in the holes.
+         *
+         * @return The number of positions.
+         */
+        static uint64_t positions(uint8_t n_marbles);
+
+        /**
+         * Get the index of a position.
+         *
+         * @param holes The 12 hole counts: the side to move's rows 0 to 5,
+         *        then the other side's, in the order of Figure 2.
+         *
+         * @return The index of the position.
+         */
+        static uint64_t rank(const uint8_t holes[12]);
+
+    private:
+        EndgameDatabase(const EndgameDatabase &);
+        EndgameDatabase &operator=(const EndgameDatabase &);
+
+        /**
+         * Unmap the mapped file, if any.
+         */
+        void unmap();
+
+        /**
+         * Solve a position with A to move and empty homes, and every
+         * position it leads to.
+         *
+         * @param state The position.
+         *
+         * @return The value of the position.
+         */
+        int8_t solve(const BoardState &state);
+
+        /**
+         * The value of each position, by index. Unsolved positions hold
+         * unsolved.
+         */
+        std::vector<int8_t> values;
+
+        /**
+         * The mapped file, or NULL if the database was generated.
+         */
+        const uint8_t *mapping;
+
+        /**
+         * The size of the mapped file.
+         */
+        size_t mapping_size;
+
+        /**
+         * The most marbles in the holes covered, or -1.
+         */
+        int16_t covered;
+    };
+}
@@ -6,6 +6,8 @@
  */
 
 #include "game.h"
+#include "board_state.h"
+#include "sowing.h"
 
 #include <cstdbool>
 #include <cstdint>
@@ -23,8 +25,18 @@ namespace Mancala
 
     GameState Game::run_round(Side current_player_side, uint8_t row)
     {
-        bool ended_in_home = false;
-        uint8_t wrap_arounds = 0;
+        GameUndo undo;
+
+        return make_move(current_player_side, row, undo);
+    }
+
+    GameState Game::make_move(Side current_player_side, uint8_t row,
+        GameUndo &undo)
+    {
+        undo.error_code = error_code;
+        undo.rounds = rounds;
+        undo.winner = winner;
+        undo.move.marbles = 0;
 
         /*
          * No repeats.
@@ -36,223 +48,60 @@ namespace Mancala
             return error_code;
         }
 
-        if (board.get_hole(current_player_side, row) == 0)
+        BoardState state = BoardState::from_board(board);
+
+        GameState result = Mancala::make_move(state, current_player_side, row,
+            undo.move);
+
+        if (result == GameState::EmptyHoleError)
         {
             error_code = GameState::EmptyHoleError;
             return GameState::EmptyHoleError;
         }
 
-        uint8_t marbles_collected = board.get_hole(
-            current_player_side, 
-            row);
+        state.to_board(board);
 
-        board.clear_hole(current_player_side, row);
+        error_code = result;
 
-        Side other_player;
-
-        /*
-         * Going to be using the sign bit.
-         */
-        int8_t row_select = static_cast<int8_t>(row);
-
-        switch(current_player_side)
+        if (error_code == GameState::GameOver)
         {
-            case Side::A:
-                other_player = Side::B;
-
-                row_select++;
-
-                for (uint8_t marbles = marbles_collected;
-                    marbles > 0;
-                    marbles--)
-                {
-                    /*
-                     * On your side.
-                     */
-                    if (wrap_arounds % 2 == 0)
-                    {
-                        if (row_select >= 6)
-                        {
-                            board.add_home(current_player_side);
-                            row_select = 5;
-                            wrap_arounds++;
-
-                            if (marbles == 1)
-                            {
-                                ended_in_home = true;                                
-                            }
-                        }
-                        else
-                        {
-                            if (marbles == 1 && 
-                                board.get_hole(current_player_side, row_select) == 0)
-                            {
-                                uint8_t marbles_stolen = 
-                                board.get_hole(other_player, row_select);
-
-                                board.clear_hole(other_player, row_select);
-
-                                board.add_home(current_player_side, marbles_stolen + 1);
-                            }
-                            else
-                            {
-                                board.add(current_player_side, row_select++);
-                            }
-                        }    
-                    }
-                    /*
-                     * On the other side.
-                     */
-                    else
-                    {
-                        board.add(other_player, row_select--);
-                        if (row_select == -1 && marbles > 0)
-                        {
-                            row_select = 0;
-                            wrap_arounds++;
-                        } 
-                    }
-                }
-
-                if (ended_in_home)
-                {
-                    error_code = GameState::SideA;
-                }
-                else
-                {
-                    error_code = GameState::SideB;
-                }
-
-                break;
-
-            case Side::B:
-                other_player = Side::A;
-                
-                row_select--;
-
-                for (uint8_t marbles = marbles_collected;
-                    marbles > 0;
-                    marbles--)
-                {
-                    /*
-                     * On your side.
-                     */
-                    if (wrap_arounds % 2 == 0)
-                    {
-                        if (row_select < 0)
-                        {
-                            board.add_home(current_player_side);
-                            row_select = 0;
-                            wrap_arounds++;
-
-                            if (marbles == 1)
-                            {
-                                ended_in_home = true;
-                            }
-                        }
-                        else
-                        {
-                            if (marbles == 1 && 
-                                board.get_hole(current_player_side, row_select) == 0)
-                            {
-                                uint8_t marbles_stolen = 
-                                board.get_hole(other_player, row_select);
-
-                                board.clear_hole(other_player, row_select);
-
-                                board.add_home(current_player_side, marbles_stolen + 1);
-                            }
-                            else
-                            {
-                                board.add(current_player_side, row_select--);                                
-                            }
-                        }    
-                    }
-                    /*
-                     * On the other side.
-                     */
-                    else
-                    {
-                        board.add(other_player, row_select++);
-
-                        if (row_select == 6 && marbles > 0)
-                        {
-                            row_select = 5;
-                            wrap_arounds++;
-                        } 
-                    }
-                }
-
-                if (ended_in_home)
-                {
-                    error_code = GameState::SideB;
-                }
-                else
-                {
-                    error_code = GameState::SideA;
-                }
-                
-                break;
-
-            default:
-                error_code = GameState::InvalidSide;
-
-                return GameState::InvalidSide;
-                break;
+            winner = leading_side(state);
         }
 
-        Side empty_side;
-        Side non_empty_side;
-
-        for (uint8_t row = 0; row < 6; row++)
-        {
-            if (board.get_hole(Mancala::Side::A, row) != 0)
-            {
-                break;
-            }
-
-            if (row == 5)
-            {
-                error_code = GameState::GameOver;
-                empty_side = Side::A;
-                non_empty_side = Side::B;
-            }
-        }
+        rounds++;
+        
+        return error_code;
+    }
 
-        for (uint8_t row = 0; row < 6; row++)
+    void Game::unmake_move(const GameUndo &undo)
+    {
+        if (undo.move.marbles != 0)
         {
-            if (board.get_hole(Side::B, row) != 0)
-            {
-                break;
-            }
+            BoardState state = BoardState::from_board(board);
 
-            if (row == 5)
-            {
-                error_code = GameState::GameOver;
+            Mancala::unmake_move(state, undo.move);
 
-                empty_side = Side::B;
-                non_empty_side = Side::A;
-            }
+            state.to_board(board);
         }
 
-        if (error_code == GameState::GameOver)
-        {
-            uint8_t surplus_marbles = 0;
-
-            for (uint8_t row = 0; row < 6; row++)
-            {
-                surplus_marbles += board.get_hole(non_empty_side, row);
-                board.clear_hole(non_empty_side, row);
-            }
+        error_code = undo.error_code;
+        rounds = undo.rounds;
+        winner = undo.winner;
+    }
 
-            board.add_home(non_empty_side, surplus_marbles);
+    MoveSet Game::legal_moves(Side side) const
+    {
+        /*
+         * Only the side's six holes are read; the board is not copied.
+         */
+        uint8_t mask = 0;
 
-            winner = board.get_home(Side::A) > board.get_home(Side::B) ? Side::A : Side::B;
+        for (uint8_t row = 0; row < BoardState::n_rows; row++)
+        {
+            mask |= static_cast<uint8_t>((board.get_hole(side, row) != 0) << row);
         }
 
-        rounds++;
-        
-        return error_code;
+        return MoveSet(mask);
     }
 
     uint16_t Game::get_rounds() const
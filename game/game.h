@@ -8,6 +8,9 @@
 #pragma once
 
 #include "board.h"
+#include "game_state.h"
+#include "move_set.h"
+#include "sowing.h"
 
 #include <cstdbool>
 #include <cstdint>
@@ -15,16 +18,31 @@
 
 namespace Mancala
 {
-    typedef enum : int8_t
+    /**
+     * Everything needed to take back a round played with Game::make_move.
+     */
+    struct GameUndo
     {
-        SideA = 1,
-        SideB = 2,
-        GameOver = 3,
+        /**
+         * The pits changed by the move.
+         */
+        MoveUndo move;
+
+        /**
+         * The last error state before the move.
+         */
+        GameState error_code;
+
+        /**
+         * The round counter before the move.
+         */
+        uint16_t rounds;
 
-        RoundFailure = -1,
-        InvalidSide = -2,
-        EmptyHoleError = -3
-    } GameState;
+        /**
+         * The winner state before the move.
+         */
+        Side winner;
+    };
 
     class Game
     {
@@ -47,6 +65,38 @@ namespace Mancala
          */
         GameState run_round(Side current_player_side, uint8_t row);
 
+        /**
+         * Run a round of the game, recording how to take it back.
+         *
+         * @param current_player_side The current player's side.
+         * @param row The row to select from.
+         * @param[out] undo The record to pass to unmake_move.
+         *
+         * @return The error code for the round played.
+         */
+        GameState make_move(Side current_player_side, uint8_t row,
+            GameUndo &undo);
+
+        /**
+         * Take back a round played with make_move, restoring the board,
+         * the round counter, the winner and the last error state.
+         *
+         * @note Rounds must be taken back in the reverse order they were
+         *       made.
+         *
+         * @param undo The record filled in by make_move.
+         */
+        void unmake_move(const GameUndo &undo);
+
+        /**
+         * Get the rows a side can play.
+         *
+         * @param side The side to move.
+         *
+         * @return The non-empty holes on the side's half of the board.
+         */
+        MoveSet legal_moves(Side side) const;
+
         /**
          * Get number of rounds played.
          *
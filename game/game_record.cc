@@ -0,0 +1,503 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A record of a played game, and the compact file format games are
+ *        archived in.
+ */
+
+#include "game_record.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Game files are read and written as little endian"
+#endif
+
+namespace Mancala
+{
+    /**
+     * The file header.
+     */
+    struct GameFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t n_marbles;
+        uint32_t block_size;
+        uint32_t reserved;
+    };
+
+    /**
+     * The header of a block.
+     */
+    struct GameBlockHeader
+    {
+        uint64_t first_game;
+        uint32_t n_games;
+        uint32_t n_bytes;
+    };
+
+    static const char game_magic[8] = {'M', 'N', 'C', 'L', 'G', 'A', 'M', 'E'};
+    static const uint32_t game_version = 2u;
+
+    /**
+     * Blocks start after a page holding the header.
+     */
+    static const uint64_t blocks_offset = 4096u;
+
+    /**
+     * The buffered bytes that trigger a write. Big enough that a write
+     * costs far more in bandwidth than in system call overhead.
+     */
+    static const size_t flush_size = 4u << 20;
+
+    /**
+     * Get the bytes a game takes in a block.
+     */
+    static inline size_t game_bytes(const uint16_t n_moves)
+    {
+        return 2u + (3u * n_moves + 7u) / 8u;
+    }
+
+    /**
+     * Check a block's header, so that reading its games cannot leave it.
+     *
+     * @param header The header.
+     * @param first_game The number of games in the blocks before it.
+     *
+     * @return True if the block's games fit in it, leaving the spare byte
+     *         GameView::row reads past the last, and are numbered on from
+     *         the blocks before it.
+     */
+    static bool valid_block(const GameBlockHeader &header, const uint64_t first_game)
+    {
+        return header.first_game == first_game &&
+            header.n_bytes + sizeof(GameBlockHeader) < GameRecordWriter::block_size &&
+            header.n_games <= header.n_bytes / game_bytes(0);
+    }
+
+    GameRecordWriter::GameRecordWriter() :
+        file(NULL),
+        block_start(0),
+        first_game(0),
+        block_games(0),
+        written(0),
+        n_marbles(0)
+    {
+    }
+
+    GameRecordWriter::~GameRecordWriter()
+    {
+        close();
+    }
+
+    bool GameRecordWriter::open(const char *path, uint8_t _n_marbles)
+    {
+        close();
+
+        file = fopen(path, "wb");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        GameFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, game_magic, sizeof(header.magic));
+        header.version = game_version;
+        header.n_marbles = _n_marbles;
+        header.block_size = block_size;
+
+        buffer.reserve(flush_size + block_size);
+        buffer.assign(blocks_offset, 0u);
+        memcpy(buffer.data(), &header, sizeof(header));
+
+        block_start = buffer.size();
+        buffer.resize(block_start + sizeof(GameBlockHeader));
+
+        n_marbles = _n_marbles;
+        first_game = 0;
+        block_games = 0;
+        written = 0;
+
+        return true;
+    }
+
+    void GameRecordWriter::end_block()
+    {
+        GameBlockHeader header;
+        header.first_game = first_game;
+        header.n_games = block_games;
+        header.n_bytes = static_cast<uint32_t>(buffer.size() - block_start - sizeof(header));
+
+        memcpy(&buffer[block_start], &header, sizeof(header));
+        buffer.resize(block_start + block_size, 0u);
+
+        first_game += block_games;
+        block_games = 0;
+    }
+
+    bool GameRecordWriter::write(const GameRecord &record)
+    {
+        if (file == NULL || record.n_marbles != n_marbles ||
+            record.n_moves > GameRecord::max_moves)
+        {
+            return false;
+        }
+
+        const size_t length = game_bytes(record.n_moves);
+
+        /*
+         * Leave a spare byte at the end of the block for GameView::row.
+         */
+        if (buffer.size() - block_start + length + 1u > block_size)
+        {
+            end_block();
+            block_start = buffer.size();
+
+            if (block_start >= flush_size && !flush())
+            {
+                return false;
+            }
+
+            buffer.resize(block_start + sizeof(GameBlockHeader));
+        }
+
+        const size_t end = buffer.size();
+
+        buffer.resize(end + length, 0u);
+        buffer[end] = static_cast<uint8_t>(record.n_moves);
+        buffer[end + 1u] = static_cast<uint8_t>(record.margin);
+
+        uint8_t *moves = &buffer[end + 2u];
+        uint32_t bits = 0;
+        uint8_t n_bits = 0;
+
+        for (uint16_t i = 0; i < record.n_moves; i++)
+        {
+            bits |= static_cast<uint32_t>(record.rows[i] & 0x7u) << n_bits;
+            n_bits += 3u;
+
+            if (n_bits >= 8u)
+            {
+                *moves++ = static_cast<uint8_t>(bits);
+                bits >>= 8;
+                n_bits -= 8u;
+            }
+        }
+
+        if (n_bits != 0)
+        {
+            *moves = static_cast<uint8_t>(bits);
+        }
+
+        block_games++;
+
+        return true;
+    }
+
+    bool GameRecordWriter::flush()
+    {
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        /*
+         * Only the finished blocks before block_start are written out.
+         */
+        const bool flushed = block_start == 0 ||
+            fwrite(buffer.data(), block_start, 1, file) == 1;
+
+        written += block_start;
+        buffer.erase(buffer.begin(), buffer.begin() + block_start);
+        block_start = 0;
+
+        return flushed;
+    }
+
+    bool GameRecordWriter::close()
+    {
+        if (file == NULL)
+        {
+            return true;
+        }
+
+        if (block_games != 0)
+        {
+            end_block();
+        }
+        else
+        {
+            buffer.resize(block_start);
+        }
+
+        block_start = buffer.size();
+
+        const bool flushed = flush();
+        const bool closed = fclose(file) == 0;
+
+        file = NULL;
+        buffer.clear();
+
+        return flushed && closed;
+    }
+
+    uint64_t GameRecordWriter::size() const
+    {
+        return written + buffer.size();
+    }
+
+    GameRecordReader::GameRecordReader() :
+        mapping(NULL),
+        mapping_size(0),
+        n_blocks(0),
+        n_games(0),
+        n_marbles(0),
+        block(0),
+        block_games(0),
+        offset(0),
+        block_end(0)
+    {
+    }
+
+    GameRecordReader::~GameRecordReader()
+    {
+        close();
+    }
+
+    void GameRecordReader::close()
+    {
+        if (mapping != NULL)
+        {
+            munmap(const_cast<uint8_t *>(mapping), mapping_size);
+        }
+
+        mapping = NULL;
+        mapping_size = 0;
+        n_blocks = 0;
+        n_games = 0;
+        block = 0;
+        block_games = 0;
+        offset = 0;
+        block_end = 0;
+    }
+
+    bool GameRecordReader::open(const char *path)
+    {
+        close();
+
+        const int fd = ::open(path, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+
+        if (fstat(fd, &status) != 0 || static_cast<uint64_t>(status.st_size) < blocks_offset)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(status.st_size);
+        void *memory = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+        /*
+         * The mapping holds its own reference to the file.
+         */
+        ::close(fd);
+
+        if (memory == MAP_FAILED)
+        {
+            return false;
+        }
+
+        mapping = static_cast<const uint8_t *>(memory);
+        mapping_size = size;
+
+        const GameFileHeader *header = reinterpret_cast<const GameFileHeader *>(mapping);
+
+        if (memcmp(header->magic, game_magic, sizeof(header->magic)) != 0 ||
+            header->version != game_version ||
+            header->block_size != GameRecordWriter::block_size ||
+            header->n_marbles == 0 || header->n_marbles > 255u)
+        {
+            close();
+            return false;
+        }
+
+        /*
+         * Games are read front to back far more often than sought.
+         */
+        madvise(memory, size, MADV_SEQUENTIAL);
+
+        n_marbles = static_cast<uint8_t>(header->n_marbles);
+        n_blocks = (size - blocks_offset) / GameRecordWriter::block_size;
+
+        for (uint64_t n = 0; n < n_blocks; n++)
+        {
+            const GameBlockHeader *block_header = reinterpret_cast<const GameBlockHeader *>(
+                mapping + blocks_offset + n * GameRecordWriter::block_size);
+
+            if (!valid_block(*block_header, n_games))
+            {
+                close();
+                return false;
+            }
+
+            n_games += block_header->n_games;
+        }
+
+        return seek_block(0) || n_blocks == 0;
+    }
+
+    uint8_t GameRecordReader::get_n_marbles() const
+    {
+        return n_marbles;
+    }
+
+    uint64_t GameRecordReader::size() const
+    {
+        return n_games;
+    }
+
+    uint64_t GameRecordReader::blocks() const
+    {
+        return n_blocks;
+    }
+
+    bool GameRecordReader::seek_block(uint64_t _block)
+    {
+        if (_block >= n_blocks)
+        {
+            return false;
+        }
+
+        const size_t start = blocks_offset + _block * GameRecordWriter::block_size;
+        const GameBlockHeader *header = reinterpret_cast<const GameBlockHeader *>(mapping + start);
+
+        /*
+         * The header was checked by open.
+         */
+        block = _block;
+        block_games = header->n_games;
+        offset = start + sizeof(GameBlockHeader);
+        block_end = offset + header->n_bytes;
+
+        return true;
+    }
+
+    bool GameRecordReader::seek(uint64_t game)
+    {
+        if (game >= n_games)
+        {
+            return false;
+        }
+
+        /*
+         * Find the last block starting at or before the game.
+         */
+        uint64_t low = 0;
+        uint64_t high = n_blocks;
+
+        while (high - low > 1u)
+        {
+            const uint64_t middle = low + (high - low) / 2u;
+            const GameBlockHeader *header = reinterpret_cast<const GameBlockHeader *>(
+                mapping + blocks_offset + middle * GameRecordWriter::block_size);
+
+            if (header->first_game <= game)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if (!seek_block(low))
+        {
+            return false;
+        }
+
+        const GameBlockHeader *header = reinterpret_cast<const GameBlockHeader *>(
+            mapping + blocks_offset + low * GameRecordWriter::block_size);
+        GameView view;
+
+        for (uint64_t skip = game - header->first_game; skip != 0; skip--)
+        {
+            if (!next(view))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool GameRecordReader::next(GameView &view)
+    {
+        while (block_games == 0)
+        {
+            if (!seek_block(block + 1u))
+            {
+                return false;
+            }
+        }
+
+        /*
+         * A corrupt game could run past its block, or hold more moves
+         * than a record.
+         */
+        if (block_end - offset < game_bytes(0) ||
+            mapping[offset] > GameRecord::max_moves ||
+            block_end - offset < game_bytes(mapping[offset]))
+        {
+            return false;
+        }
+
+        view.n_moves = mapping[offset];
+        view.margin = static_cast<int8_t>(mapping[offset + 1u]);
+        view.moves = mapping + offset + 2u;
+
+        offset += game_bytes(view.n_moves);
+        block_games--;
+
+        return true;
+    }
+
+    bool GameRecordReader::next(GameRecord &record)
+    {
+        GameView view;
+
+        if (!next(view))
+        {
+            return false;
+        }
+
+        record.n_marbles = n_marbles;
+        record.margin = view.margin;
+        record.n_moves = view.n_moves;
+
+        for (uint16_t i = 0; i < view.n_moves; i++)
+        {
+            record.rows[i] = view.row(i);
+        }
+
+        return true;
+    }
+}
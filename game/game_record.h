@@ -0,0 +1,368 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A record of a played game, and the compact file format games are
+ *        archived in.
+ */
+
+#pragma once
+
+#include "board_state.h"
+
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace Mancala
+{
+    /**
+     * A game played from the opening, A moving first.
+     *
+     * Only the rows are kept: the side making each move follows from
+     * replaying the ones before it.
+     */
+    struct GameRecord
+    {
+        /**
+         * The most moves a record can hold, so that a record fills 256
+         * bytes.
+         */
+        static const uint16_t max_moves = 252u;
+
+        /**
+         * The marbles in each hole at the opening.
+         */
+        uint8_t n_marbles;
+
+        /**
+         * The final home of A less the final home of B.
+         */
+        int8_t margin;
+
+        /**
+         * The number of moves played.
+         */
+        uint16_t n_moves;
+
+        /**
+         * The row of each move.
+         */
+        uint8_t rows[max_moves];
+    };
+
+    static_assert(sizeof(GameRecord) == 256u,
+        "A game record must fill 256 bytes");
+
+    /*
+     * A game file holds games that all start with the same number of
+     * marbles. It is a header page, then a run of fixed size blocks:
+     *
+     *     header: magic, version, marbles, block size
+     *     block : its first game's number, its number of games, the bytes
+     *             of games it holds, then the games, then zeros to the
+     *             end of the block.
+     *     game  : the number of moves (one byte), the margin (one signed
+     *             byte), then the rows at 3 bits each, the first row in
+     *             the lowest bits, rounded up to a whole byte.
+     *
+     * A game never spans two blocks, so block k can be read on its own
+     * at a fixed offset, and a game can be found by its number with a
+     * binary search of the blocks. A file cut short ends with whole
+     * blocks once the partial one at its end is dropped.
+     */
+
+    /**
+     * A game read straight out of a mapped game file.
+     */
+    struct GameView
+    {
+        /**
+         * The number of moves played.
+         */
+        uint8_t n_moves;
+
+        /**
+         * The final home of A less the final home of B.
+         */
+        int8_t margin;
+
+        /**
+         * The packed rows.
+         */
+        const uint8_t *moves;
+
+        /**
+         * Get the row of a move.
+         *
+         * @param move The move's number, from 0.
+         *
+         * @return The row.
+         */
+        uint8_t row(const uint16_t move) const
+        {
+            const uint32_t bit = 3u * move;
+
+            /*
+             * Every block ends with at least one spare byte, so the byte
+             * after a game's last one can always be read.
+             */
+            const uint32_t pair = moves[bit >> 3] | static_cast<uint32_t>(moves[(bit >> 3) + 1u]) << 8;
+
+            return static_cast<uint8_t>((pair >> (bit & 7u)) & 0x7u);
+        }
+    };
+
+    /**
+     * Writes games to a game file, a block at a time.
+     */
+    class GameRecordWriter
+    {
+
+    public:
+        /**
+         * The size of a block in bytes.
+         */
+        static const uint32_t block_size = 64u << 10;
+
+        /**
+         * Constructor.
+         */
+        GameRecordWriter();
+
+        /**
+         * Destructor. Closes the file.
+         */
+        ~GameRecordWriter();
+
+        /**
+         * Create a file, replacing any file already there.
+         *
+         * @param path The file.
+         * @param n_marbles The marbles in each hole at the opening of
+         *        every game.
+         *
+         * @return True on success.
+         */
+        bool open(const char *path, uint8_t n_marbles);
+
+        /**
+         * Add a game to the file.
+         *
+         * @param record The game. Its marbles must match the file's.
+         *
+         * @return True on success.
+         */
+        bool write(const GameRecord &record);
+
+        /**
+         * Write out the buffered games and close the file.
+         *
+         * @return True on success.
+         */
+        bool close();
+
+        /**
+         * Get the number of bytes written so far, including the header,
+         * the finished blocks and the games of the block being filled.
+         *
+         * @return The number of bytes.
+         */
+        uint64_t size() const;
+
+    private:
+        GameRecordWriter(const GameRecordWriter &);
+        GameRecordWriter &operator=(const GameRecordWriter &);
+
+        /**
+         * Close the block being filled, padding it to its full size.
+         */
+        void end_block();
+
+        /**
+         * Write out the buffered blocks.
+         *
+         * @return True on success.
+         */
+        bool flush();
+
+        /**
+         * The open file, or NULL.
+         */
+        FILE *file;
+
+        /**
+         * The finished blocks not written out yet, then the block being
+         * filled.
+         */
+        std::vector<uint8_t> buffer;
+
+        /**
+         * Where the block being filled starts in the buffer.
+         */
+        size_t block_start;
+
+        /**
+         * The number of games before the block being filled.
+         */
+        uint64_t first_game;
+
+        /**
+         * The number of games in the block being filled.
+         */
+        uint32_t block_games;
+
+        /**
+         * The bytes written out.
+         */
+        uint64_t written;
+
+        /**
+         * The marbles in each hole at the opening.
+         */
+        uint8_t n_marbles;
+    };
+
+    /**
+     * Reads a game file in place: the file is mapped read-only and games
+     * are viewed where they lie, so nothing is copied to scan it.
+     */
+    class GameRecordReader
+    {
+
+    public:
+        /**
+         * Constructor.
+         */
+        GameRecordReader();
+
+        /**
+         * Destructor. Unmaps the file.
+         */
+        ~GameRecordReader();
+
+        /**
+         * Map a game file, and go to its first game.
+         *
+         * @param path The file.
+         *
+         * @return True on success, or false if the file could not be
+         *         read or any of its block headers is corrupt.
+         */
+        bool open(const char *path);
+
+        /**
+         * Unmap the file.
+         */
+        void close();
+
+        /**
+         * Get the marbles in each hole at the opening of every game.
+         *
+         * @return The marble count.
+         */
+        uint8_t get_n_marbles() const;
+
+        /**
+         * Get the number of games in the file.
+         *
+         * @return The number of games.
+         */
+        uint64_t size() const;
+
+        /**
+         * Get the number of blocks in the file.
+         *
+         * @return The number of blocks.
+         */
+        uint64_t blocks() const;
+
+        /**
+         * Go to the first game of a block.
+         *
+         * @param block The block.
+         *
+         * @return False if there is no such block.
+         */
+        bool seek_block(uint64_t block);
+
+        /**
+         * Go to a game.
+         *
+         * @param game The game's number, from 0.
+         *
+         * @return False if there is no such game.
+         */
+        bool seek(uint64_t game);
+
+        /**
+         * Read the next game in place.
+         *
+         * @param[out] view The game, valid until the file is closed.
+         *
+         * @return False at the end of the file, or at a corrupt game.
+         */
+        bool next(GameView &view);
+
+        /**
+         * Read and unpack the next game.
+         *
+         * @param[out] record The game.
+         *
+         * @return False at the end of the file, or at a corrupt game.
+         */
+        bool next(GameRecord &record);
+
+    private:
+        GameRecordReader(const GameRecordReader &);
+        GameRecordReader &operator=(const GameRecordReader &);
+
+        /**
+         * The mapped file, or NULL.
+         */
+        const uint8_t *mapping;
+
+        /**
+         * The size of the mapped file.
+         */
+        size_t mapping_size;
+
+        /**
+         * The number of whole blocks.
+         */
+        uint64_t n_blocks;
+
+        /**
+         * The number of games in the whole blocks.
+         */
+        uint64_t n_games;
+
+        /**
+         * The marbles in each hole at the opening.
+         */
+        uint8_t n_marbles;
+
+        /**
+         * The block being read.
+         */
+        uint64_t block;
+
+        /**
+         * The games of the block left to read.
+         */
+        uint32_t block_games;
+
+        /**
+         * Where the next game starts in the mapping.
+         */
+        size_t offset;
+
+        /**
+         * Where the games of the block being read end in the mapping.
+         */
+        size_t block_end;
+    };
+}
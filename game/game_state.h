@@ -0,0 +1,24 @@
+/**
+ * @author Sargis S Yonan
+ * @date 2 October 2018
+ *
+ * @brief The result codes of a round of mancala.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Mancala
+{
+    typedef enum : int8_t
+    {
+        SideA = 1,
+        SideB = 2,
+        GameOver = 3,
+
+        RoundFailure = -1,
+        InvalidSide = -2,
+        EmptyHoleError = -3
+    } GameState;
+}
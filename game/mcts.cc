@@ -0,0 +1,503 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A Monte Carlo tree search engine for a computer opponent.
+ */
+
+#include "mcts.h"
+#include "sowing.h"
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /*
+     * A node's expansion goes from unexpanded to expanding once, by the
+     * thread that gives it its children, and to expanded once they are
+     * written. A node left expanding is a leaf for good: the arena ran
+     * out before its children could be added.
+     */
+    static const uint8_t unexpanded = 0u;
+    static const uint8_t expanding = 1u;
+    static const uint8_t expanded = 2u;
+
+    /**
+     * The weight of exploring rarely visited moves in UCB1.
+     */
+    static const double exploration = 1.4;
+
+    /**
+     * Get the side that moves next after a move.
+     */
+    static inline Side next_side(const GameState result)
+    {
+        return result == GameState::SideA ? Side::A : Side::B;
+    }
+
+    /**
+     * Get the half points A won in a finished game.
+     */
+    static inline uint32_t a_points(const uint8_t home_a, const uint8_t home_b)
+    {
+        return home_a > home_b ? 2u : home_a == home_b ? 1u : 0u;
+    }
+
+    MonteCarloSearch::MonteCarloSearch(size_t megabytes) :
+        nodes(NULL),
+        n_nodes(0),
+        used(0),
+        started(0),
+        stop(false),
+        book(NULL),
+        root_side(Side::A)
+    {
+        size_t count = (megabytes << 20) / sizeof(Node);
+
+        if (count > UINT32_MAX)
+        {
+            count = UINT32_MAX;
+        }
+
+        if (count < 1u + BoardState::n_rows)
+        {
+            count = 1u + BoardState::n_rows;
+        }
+
+        nodes = new Node[count];
+        n_nodes = static_cast<uint32_t>(count);
+    }
+
+    MonteCarloSearch::~MonteCarloSearch()
+    {
+        delete[] nodes;
+    }
+
+    size_t MonteCarloSearch::capacity() const
+    {
+        return n_nodes;
+    }
+
+    void MonteCarloSearch::set_book(const OpeningBook *_book)
+    {
+        book = _book;
+    }
+
+    void MonteCarloSearch::expand(uint32_t index, const BoardState &state, Side side)
+    {
+        Node &node = nodes[index];
+        uint8_t expected = unexpanded;
+
+        if (!node.expansion.compare_exchange_strong(expected, expanding,
+            std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        const MoveSet legal = state.legal_moves(side);
+        const uint32_t first = used.fetch_add(legal.size(), std::memory_order_relaxed);
+
+        if (first + legal.size() > n_nodes)
+        {
+            return;
+        }
+
+        uint32_t child = first;
+
+        for (uint8_t row : legal)
+        {
+            nodes[child].visits.store(0, std::memory_order_relaxed);
+            nodes[child].score.store(0, std::memory_order_relaxed);
+            nodes[child].virtual_loss.store(0, std::memory_order_relaxed);
+            nodes[child].children.store(0, std::memory_order_relaxed);
+            nodes[child].expansion.store(unexpanded, std::memory_order_relaxed);
+            nodes[child].n_children = 0;
+            nodes[child].row = row;
+            nodes[child].mover = side;
+            child++;
+        }
+
+        node.children.store(first, std::memory_order_relaxed);
+        node.n_children = legal.size();
+        node.expansion.store(expanded, std::memory_order_release);
+    }
+
+    GameState MonteCarloSearch::descend(Worker &worker, BoardState &state, Side &side)
+    {
+        const uint32_t n = limits.batch;
+
+        worker.path.clear();
+        worker.path.push_back(0);
+        nodes[0].virtual_loss.fetch_add(n, std::memory_order_relaxed);
+
+        state = root_state;
+        side = root_side;
+
+        uint32_t index = 0;
+
+        while (true)
+        {
+            Node &node = nodes[index];
+
+            if (node.expansion.load(std::memory_order_acquire) != expanded)
+            {
+                /*
+                 * A leaf is played out once before it is given children,
+                 * so that the tree only grows where playouts return.
+                 */
+                if (node.visits.load(std::memory_order_relaxed) == 0)
+                {
+                    return side == Side::A ? GameState::SideA : GameState::SideB;
+                }
+
+                expand(index, state, side);
+
+                if (node.expansion.load(std::memory_order_acquire) != expanded)
+                {
+                    return side == Side::A ? GameState::SideA : GameState::SideB;
+                }
+            }
+
+            /*
+             * UCB1, with the playouts still running through a node counted
+             * as lost.
+             */
+            const uint32_t first = node.children.load(std::memory_order_relaxed);
+            const double log_parent = std::log(static_cast<double>(
+                node.visits.load(std::memory_order_relaxed) +
+                node.virtual_loss.load(std::memory_order_relaxed)));
+
+            uint32_t best = first;
+            double best_value = -1.0;
+
+            for (uint32_t child = first; child < first + node.n_children; child++)
+            {
+                const uint32_t visits = nodes[child].visits.load(std::memory_order_relaxed) +
+                    nodes[child].virtual_loss.load(std::memory_order_relaxed);
+
+                if (visits == 0)
+                {
+                    best = child;
+                    break;
+                }
+
+                const double value = nodes[child].score.load(std::memory_order_relaxed) / (2.0 * visits) +
+                    exploration * std::sqrt(log_parent / visits);
+
+                if (value > best_value)
+                {
+                    best_value = value;
+                    best = child;
+                }
+            }
+
+            worker.path.push_back(best);
+            nodes[best].virtual_loss.fetch_add(n, std::memory_order_relaxed);
+
+            const GameState result = apply_move(state, side, nodes[best].row);
+
+            if (result == GameState::GameOver)
+            {
+                return result;
+            }
+
+            side = next_side(result);
+            index = best;
+        }
+    }
+
+    uint32_t MonteCarloSearch::playout(Worker &worker, const BoardState &state,
+        Side side, uint16_t n)
+    {
+        if (n == 1u)
+        {
+            BoardState game = state;
+            MoveSet legal = game.legal_moves(side);
+
+            while (true)
+            {
+                const GameState result = apply_move(game, side,
+                    worker.random.pick(legal));
+
+                if (result == GameState::GameOver)
+                {
+                    break;
+                }
+
+                side = next_side(result);
+                legal = game.legal_moves(side);
+            }
+
+            return a_points(game.get_home(Side::A), game.get_home(Side::B));
+        }
+
+        BoardBatch &games = worker.games;
+
+        for (uint16_t i = 0; i < n; i++)
+        {
+            games.set(i, state);
+            worker.sides[i] = side;
+        }
+
+        const uint8_t *a_pits[BoardState::n_rows];
+        const uint8_t *b_pits[BoardState::n_rows];
+
+        for (uint8_t row = 0; row < BoardState::n_rows; row++)
+        {
+            a_pits[row] = games.pit(BoardState::pit(Side::A, row));
+            b_pits[row] = games.pit(BoardState::pit(Side::B, row));
+        }
+
+        /*
+         * One move for every game at a time. Once a game is over its holes
+         * are empty, it is given no row, and the batch leaves it alone.
+         */
+        while (true)
+        {
+            uint16_t running = 0;
+
+            for (uint16_t i = 0; i < n; i++)
+            {
+                const uint8_t *const *pits = worker.sides[i] == Side::A ? a_pits : b_pits;
+                uint8_t mask = 0;
+
+                for (uint8_t row = 0; row < BoardState::n_rows; row++)
+                {
+                    mask |= static_cast<uint8_t>((pits[row][i] != 0) << row);
+                }
+
+                if (mask == 0)
+                {
+                    worker.rows[i] = 0xFF;
+                    continue;
+                }
+
+                worker.rows[i] = worker.random.pick(MoveSet(mask));
+                running++;
+            }
+
+            if (running == 0)
+            {
+                break;
+            }
+
+            games.apply_moves(worker.sides.data(), worker.rows.data(),
+                worker.results.data());
+
+            for (uint16_t i = 0; i < n; i++)
+            {
+                if (worker.results[i] == GameState::SideA ||
+                    worker.results[i] == GameState::SideB)
+                {
+                    worker.sides[i] = next_side(worker.results[i]);
+                }
+            }
+        }
+
+        const uint8_t *home_a = games.pit(BoardState::home(Side::A));
+        const uint8_t *home_b = games.pit(BoardState::home(Side::B));
+        uint32_t points = 0;
+
+        for (uint16_t i = 0; i < n; i++)
+        {
+            points += a_points(home_a[i], home_b[i]);
+        }
+
+        return points;
+    }
+
+    void MonteCarloSearch::backup(const Worker &worker, uint32_t a_score, uint16_t n)
+    {
+        const uint32_t b_score = 2u * n - a_score;
+
+        for (size_t i = 0; i < worker.path.size(); i++)
+        {
+            Node &node = nodes[worker.path[i]];
+
+            node.score.fetch_add(node.mover == Side::A ? a_score : b_score,
+                std::memory_order_relaxed);
+            node.visits.fetch_add(n, std::memory_order_relaxed);
+            node.virtual_loss.fetch_sub(n, std::memory_order_relaxed);
+        }
+    }
+
+    bool MonteCarloSearch::finished()
+    {
+        if (stop.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        bool done = false;
+
+        if (limits.playouts != 0)
+        {
+            done = started.fetch_add(limits.batch, std::memory_order_relaxed) >= limits.playouts;
+        }
+        else if (limits.time_ms == 0)
+        {
+            done = used.load(std::memory_order_relaxed) + BoardState::n_rows > n_nodes;
+        }
+
+        if (!done && limits.time_ms != 0)
+        {
+            const std::chrono::steady_clock::duration elapsed =
+                std::chrono::steady_clock::now() - start;
+
+            done = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits.time_ms;
+        }
+
+        if (done)
+        {
+            stop.store(true, std::memory_order_relaxed);
+        }
+
+        return done;
+    }
+
+    void MonteCarloSearch::work(Worker &worker)
+    {
+        const uint16_t n = limits.batch;
+
+        worker.games.resize(n);
+        worker.sides.resize(n);
+        worker.rows.resize(n);
+        worker.results.resize(n);
+        worker.playouts = 0;
+
+        while (!finished())
+        {
+            BoardState state;
+            Side side;
+            uint32_t a_score;
+
+            if (descend(worker, state, side) == GameState::GameOver)
+            {
+                /*
+                 * The game is over at the leaf, so every playout from it
+                 * ends the same way.
+                 */
+                a_score = n * a_points(state.get_home(Side::A), state.get_home(Side::B));
+            }
+            else
+            {
+                a_score = playout(worker, state, side, n);
+            }
+
+            backup(worker, a_score, n);
+            worker.playouts += n;
+        }
+    }
+
+    MonteCarloResult MonteCarloSearch::think(const BoardState &state, Side side,
+        const MonteCarloLimits &_limits)
+    {
+        start = std::chrono::steady_clock::now();
+        limits = _limits;
+
+        if (limits.batch == 0)
+        {
+            limits.batch = 1u;
+        }
+
+        if (limits.threads == 0)
+        {
+            limits.threads = 1u;
+        }
+
+        root_state = state;
+        root_side = side;
+        used.store(1u, std::memory_order_relaxed);
+        started.store(0, std::memory_order_relaxed);
+        stop.store(false, std::memory_order_relaxed);
+
+        Node &root = nodes[0];
+        root.visits.store(0, std::memory_order_relaxed);
+        root.score.store(0, std::memory_order_relaxed);
+        root.virtual_loss.store(0, std::memory_order_relaxed);
+        root.expansion.store(unexpanded, std::memory_order_relaxed);
+        root.n_children = 0;
+        root.row = 0xFF;
+        root.mover = side == Side::A ? Side::B : Side::A;
+
+        MonteCarloResult result;
+        result.row = 0xFF;
+        result.win_rate = 0.0;
+        result.visits = 0;
+        result.playouts = 0;
+
+        const MoveSet legal = state.legal_moves(side);
+        BookEntry entry;
+
+        if (book != NULL && book->probe(state, side, entry))
+        {
+            result.row = entry.row;
+            result.win_rate = entry.value > 0 ? 1.0 : entry.value == 0 ? 0.5 : 0.0;
+        }
+        else if (!legal.empty())
+        {
+            expand(0, state, side);
+
+            std::vector<Worker> workers(limits.threads);
+            std::vector<std::thread> threads;
+
+            for (uint8_t i = 0; i < workers.size(); i++)
+            {
+                workers[i].random = Random(i);
+                workers[i].path.reserve(256u);
+            }
+
+            for (uint8_t i = 1; i < workers.size(); i++)
+            {
+                threads.push_back(std::thread(&MonteCarloSearch::work, this,
+                    std::ref(workers[i])));
+            }
+
+            work(workers[0]);
+
+            for (uint8_t i = 0; i < threads.size(); i++)
+            {
+                threads[i].join();
+            }
+
+            for (uint8_t i = 0; i < workers.size(); i++)
+            {
+                result.playouts += workers[i].playouts;
+            }
+
+            const uint32_t first = root.children.load(std::memory_order_relaxed);
+
+            for (uint32_t child = first; child < first + root.n_children; child++)
+            {
+                const uint32_t visits = nodes[child].visits.load(std::memory_order_relaxed);
+
+                if (result.row == 0xFF || visits > result.visits)
+                {
+                    result.row = nodes[child].row;
+                    result.visits = visits;
+                    result.win_rate = visits == 0 ? 0.0 :
+                        nodes[child].score.load(std::memory_order_relaxed) / (2.0 * visits);
+                }
+            }
+        }
+
+        const uint32_t n_used = used.load(std::memory_order_relaxed);
+
+        result.nodes = n_used < n_nodes ? n_used : n_nodes;
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        result.playouts_per_core = result.seconds > 0.0 ?
+            result.playouts / result.seconds / limits.threads : 0.0;
+
+        return result;
+    }
+}
@@ -0,0 +1,360 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A Monte Carlo tree search engine for a computer opponent.
+ */
+
+#pragma once
+
+#include "batch.h"
+#include "board_state.h"
+#include "opening_book.h"
+#include "random.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mancala
+{
+    /**
+     * When a Monte Carlo search should stop.
+     */
+    struct MonteCarloLimits
+    {
+        MonteCarloLimits() : playouts(0), time_ms(0), threads(1), batch(32u)
+        {
+        }
+
+        /**
+         * The number of playouts to run, 0 for no limit.
+         */
+        uint64_t playouts;
+
+        /**
+         * The time budget for the move in milliseconds, 0 for none.
+         */
+        uint32_t time_ms;
+
+        /**
+         * The number of threads descending the tree.
+         */
+        uint8_t threads;
+
+        /**
+         * The number of playouts run together from each new leaf.
+         */
+        uint16_t batch;
+    };
+
+    /**
+     * The outcome of a Monte Carlo search.
+     */
+    struct MonteCarloResult
+    {
+        /**
+         * The most visited row, or 0xFF if the side has no moves.
+         */
+        uint8_t row;
+
+        /**
+         * The share of the playouts through the row that the side to move
+         * won, counting a draw as half a win. For a book move: 1, 0.5 or 0
+         * as the book's value is a win, a draw or a loss.
+         */
+        double win_rate;
+
+        /**
+         * The number of playouts through the row.
+         */
+        uint64_t visits;
+
+        /**
+         * The number of playouts run, by all threads.
+         */
+        uint64_t playouts;
+
+        /**
+         * The number of tree nodes used.
+         */
+        size_t nodes;
+
+        /**
+         * The time spent searching in seconds.
+         */
+        double seconds;
+
+        /**
+         * The playouts run per second by each thread.
+         */
+        double playouts_per_core;
+    };
+
+    /**
+     * A UCT search: a tree of the positions visited is grown one leaf at
+     * a time, and each new leaf is scored by playing games out from it
+     * with random moves. Moves are picked on the way down by UCB1, from
+     * the playouts' results so far.
+     *
+     * Nodes are carved out of one arena allocated up front, the children
+     * of a node side by side, so growing the tree never allocates. Nodes
+     * hold no positions: a thread replays the moves from the root to the
+     * leaf on a flat BoardState with apply_move.
+     *
+     * Any number of threads can descend the shared tree at once without
+     * locks. A thread adds a virtual loss to every node it passes, which
+     * it takes back with the real result, so that other threads are
+     * steered to other lines while its playouts are running.
+     *
+     * The playouts from a leaf are run as one BoardBatch, a move for each
+     * unfinished game at a time, rather than one game after another.
+     *
+     * A move that ends in the mover's home is followed by another move of
+     * the same side, and a node records which side moved into it so that
+     * results are credited to the right side.
+     *
+     * A position found in an opening book, if one is given, is not
+     * searched: its book move is played.
+     */
+    class MonteCarloSearch
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param megabytes The size of the node arena.
+         */
+        explicit MonteCarloSearch(size_t megabytes = 64u);
+
+        /**
+         * Destructor.
+         */
+        ~MonteCarloSearch();
+
+        /**
+         * Find the best move for a side. The tree is grown from scratch.
+         *
+         * @param state The position to search.
+         * @param side The side to move.
+         * @param limits When to stop searching. With no playout or time
+         *        limit the search stops when the arena is full.
+         *
+         * @return The most visited move.
+         */
+        MonteCarloResult think(const BoardState &state, Side side,
+            const MonteCarloLimits &limits);
+
+        /**
+         * Set the opening book to probe before searching.
+         *
+         * @param _book The book, or NULL for none. The book is not owned
+         *        by the search.
+         */
+        void set_book(const OpeningBook *_book);
+
+        /**
+         * Get the number of nodes the arena holds.
+         *
+         * @return The number of nodes.
+         */
+        size_t capacity() const;
+
+    private:
+        MonteCarloSearch(const MonteCarloSearch &);
+        MonteCarloSearch &operator=(const MonteCarloSearch &);
+
+        /**
+         * A position in the tree, reached by playing row from its parent.
+         */
+        struct Node
+        {
+            /**
+             * The number of playouts through the node.
+             */
+            std::atomic<uint32_t> visits;
+
+            /**
+             * The half points the side that moved into the node won in
+             * those playouts: two for a win, one for a draw.
+             */
+            std::atomic<uint32_t> score;
+
+            /**
+             * The playouts through the node still running.
+             */
+            std::atomic<uint32_t> virtual_loss;
+
+            /**
+             * The index of the first child in the arena.
+             */
+            std::atomic<uint32_t> children;
+
+            /**
+             * Unexpanded, expanding, or expanded (see mcts.cc).
+             */
+            std::atomic<uint8_t> expansion;
+
+            /**
+             * The number of children.
+             */
+            uint8_t n_children;
+
+            /**
+             * The row played from the parent.
+             */
+            uint8_t row;
+
+            /**
+             * The side that played row.
+             */
+            Side mover;
+        };
+
+        /**
+         * What one thread needs to run playouts.
+         */
+        struct Worker
+        {
+            /**
+             * The thread's random numbers.
+             */
+            Random random;
+
+            /**
+             * The nodes from the root down to the current leaf.
+             */
+            std::vector<uint32_t> path;
+
+            /**
+             * The playouts from the current leaf.
+             */
+            BoardBatch games;
+
+            /**
+             * Scratch for the batch: the side to move, row and result of
+             * each game.
+             */
+            std::vector<Side> sides;
+            std::vector<uint8_t> rows;
+            std::vector<GameState> results;
+
+            /**
+             * The number of playouts run.
+             */
+            uint64_t playouts;
+        };
+
+        /**
+         * Run playouts until a limit is reached.
+         *
+         * @param worker The thread's state.
+         */
+        void work(Worker &worker);
+
+        /**
+         * Walk down from the root, expanding the leaf reached.
+         *
+         * @param worker The thread's state. The path is filled in.
+         * @param[out] state The leaf's position.
+         * @param[out] side The side to move at the leaf.
+         *
+         * @return GameOver if the leaf ends the game, otherwise the side
+         *         to move.
+         */
+        GameState descend(Worker &worker, BoardState &state, Side &side);
+
+        /**
+         * Give a node its children, if no other thread is doing so.
+         *
+         * @param index The node.
+         * @param state The node's position.
+         * @param side The side to move at the node.
+         */
+        void expand(uint32_t index, const BoardState &state, Side side);
+
+        /**
+         * Play games out from a position with random moves.
+         *
+         * @param worker The thread's state.
+         * @param state The position.
+         * @param side The side to move.
+         * @param n The number of games.
+         *
+         * @return The half points A won in the games.
+         */
+        uint32_t playout(Worker &worker, const BoardState &state, Side side,
+            uint16_t n);
+
+        /**
+         * Credit the result of playouts to the path, and take back its
+         * virtual losses.
+         *
+         * @param worker The thread's state.
+         * @param a_score The half points A won.
+         * @param n The number of playouts.
+         */
+        void backup(const Worker &worker, uint32_t a_score, uint16_t n);
+
+        /**
+         * Check if the search should stop.
+         *
+         * @return True once a limit is reached.
+         */
+        bool finished();
+
+        /**
+         * The node arena.
+         */
+        Node *nodes;
+
+        /**
+         * The number of nodes in the arena.
+         */
+        uint32_t n_nodes;
+
+        /**
+         * The number of nodes handed out.
+         */
+        std::atomic<uint32_t> used;
+
+        /**
+         * The number of playouts started, by all threads.
+         */
+        std::atomic<uint64_t> started;
+
+        /**
+         * Set once a limit is reached.
+         */
+        std::atomic<bool> stop;
+
+        /**
+         * The opening book, or NULL.
+         */
+        const OpeningBook *book;
+
+        /**
+         * The position at the root.
+         */
+        BoardState root_state;
+
+        /**
+         * The side to move at the root.
+         */
+        Side root_side;
+
+        /**
+         * The limits of the current search.
+         */
+        MonteCarloLimits limits;
+
+        /**
+         * When the search started.
+         */
+        std::chrono::steady_clock::time_point start;
+    };
+}
@@ -0,0 +1,193 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An opening book of best moves, built offline and probed before
+ *        searching.
+ */
+
+#include "opening_book.h"
+
+#include <algorithm>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Book files are read as little endian"
+#endif
+
+namespace Mancala
+{
+    /**
+     * The file header. The entries follow it.
+     */
+    struct BookHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t n_marbles;
+        uint64_t n_entries;
+        uint64_t reserved;
+    };
+
+    static const char book_magic[8] = {'M', 'N', 'C', 'L', 'B', 'O', 'O', 'K'};
+    static const uint32_t book_version = 1u;
+
+    static bool key_less(const BookEntry &entry, const uint64_t key)
+    {
+        return entry.key < key;
+    }
+
+    OpeningBook::OpeningBook() :
+        mapping(NULL),
+        mapping_size(0),
+        entries(NULL),
+        n_entries(0),
+        n_marbles(0)
+    {
+    }
+
+    OpeningBook::~OpeningBook()
+    {
+        unmap();
+    }
+
+    void OpeningBook::unmap()
+    {
+        if (mapping != NULL)
+        {
+            munmap(const_cast<uint8_t *>(mapping), mapping_size);
+        }
+
+        mapping = NULL;
+        mapping_size = 0;
+        entries = NULL;
+        n_entries = 0;
+        n_marbles = 0;
+    }
+
+    bool OpeningBook::save(const char *path, uint8_t _n_marbles,
+        std::vector<BookEntry> &book)
+    {
+        std::sort(book.begin(), book.end(),
+            [](const BookEntry &a, const BookEntry &b) { return a.key < b.key; });
+
+        FILE *file = fopen(path, "wb");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        BookHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, book_magic, sizeof(header.magic));
+        header.version = book_version;
+        header.n_marbles = _n_marbles;
+        header.n_entries = book.size();
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            (book.empty() || fwrite(book.data(), sizeof(BookEntry), book.size(), file) == book.size());
+
+        written = fclose(file) == 0 && written;
+
+        return written;
+    }
+
+    bool OpeningBook::load(const char *path)
+    {
+        unmap();
+
+        const int fd = open(path, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(BookHeader))
+        {
+            close(fd);
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(status.st_size);
+        void *memory = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+
+        /*
+         * The mapping holds its own reference to the file.
+         */
+        close(fd);
+
+        if (memory == MAP_FAILED)
+        {
+            return false;
+        }
+
+        mapping = static_cast<const uint8_t *>(memory);
+        mapping_size = size;
+
+        const BookHeader *header = reinterpret_cast<const BookHeader *>(mapping);
+
+        if (memcmp(header->magic, book_magic, sizeof(header->magic)) != 0 ||
+            header->version != book_version ||
+            header->n_marbles == 0 || header->n_marbles > 255u ||
+            header->n_entries > (size - sizeof(BookHeader)) / sizeof(BookEntry))
+        {
+            unmap();
+            return false;
+        }
+
+        entries = reinterpret_cast<const BookEntry *>(mapping + sizeof(BookHeader));
+        n_entries = header->n_entries;
+        n_marbles = static_cast<uint8_t>(header->n_marbles);
+
+        /*
+         * A book is small and every game starts in it.
+         */
+        madvise(memory, size, MADV_WILLNEED);
+
+        return true;
+    }
+
+    bool OpeningBook::probe(const BoardState &state, Side side, BookEntry &entry) const
+    {
+        if (n_entries == 0)
+        {
+            return false;
+        }
+
+        const uint64_t key = state.key(side);
+        const BookEntry *found = std::lower_bound(entries, entries + n_entries, key, key_less);
+
+        if (found == entries + n_entries || found->key != key ||
+            !state.legal_moves(side).contains(found->row))
+        {
+            return false;
+        }
+
+        entry = *found;
+
+        return true;
+    }
+
+    uint8_t OpeningBook::get_n_marbles() const
+    {
+        return n_marbles;
+    }
+
+    size_t OpeningBook::size() const
+    {
+        return n_entries;
+    }
+}
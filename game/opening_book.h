@@ -0,0 +1,182 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An opening book of best moves, built offline and probed before
+ *        searching.
+ */
+
+#pragma once
+
+#include "board_state.h"
+
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * Where a book move came from.
+     */
+    typedef enum : uint8_t
+    {
+        /*
+         * The move did best in self-play games through the position.
+         */
+        Played = 0,
+
+        /*
+         * The move was proven best by the solver.
+         */
+        Solved = 1
+    } BookSource;
+
+    /**
+     * The book's move for a position.
+     */
+    struct BookEntry
+    {
+        /**
+         * The position's key, from BoardState::key.
+         */
+        uint64_t key;
+
+        /**
+         * The final home of the side to move less the other side's:
+         * exact for a solved move, the mean over the games for a played
+         * one.
+         */
+        int16_t value;
+
+        /**
+         * The row to play.
+         */
+        uint8_t row;
+
+        /**
+         * Where the move came from.
+         */
+        BookSource source;
+
+        /**
+         * The number of games the move was played in, 0 for a solved
+         * move.
+         */
+        uint32_t games;
+    };
+
+    static_assert(sizeof(BookEntry) == 16u,
+        "Book entries must be 16 bytes");
+
+    /**
+     * A table of positions near the opening and the move to play in each,
+     * kept sorted by key in a file that is mapped read-only.
+     *
+     * A book is built once, from the solver's proven values or from
+     * self-play games (see tools/book.cc), and then opened by every
+     * engine, which plays its move without searching when the position
+     * is in it. A probe is a binary search of the mapped entries, so
+     * opening a book costs nothing and its pages are shared by every
+     * process using it.
+     */
+    class OpeningBook
+    {
+
+    public:
+        /**
+         * Constructor for an empty book.
+         */
+        OpeningBook();
+
+        /**
+         * Destructor.
+         */
+        ~OpeningBook();
+
+        /**
+         * Write a book file.
+         *
+         * @param path The file to write.
+         * @param n_marbles The marbles in each hole at the opening the
+         *        book was built from.
+         * @param[in,out] entries The entries, one per key. They are
+         *        sorted.
+         *
+         * @return True on success.
+         */
+        static bool save(const char *path, uint8_t n_marbles,
+            std::vector<BookEntry> &entries);
+
+        /**
+         * Map a book file into memory.
+         *
+         * @param path The file to map.
+         *
+         * @return True on success.
+         */
+        bool load(const char *path);
+
+        /**
+         * Look up the move for a position.
+         *
+         * @param state The position.
+         * @param side The side to move.
+         * @param[out] entry The book's move.
+         *
+         * @return True if the position is in the book with a legal move.
+         */
+        bool probe(const BoardState &state, Side side, BookEntry &entry) const;
+
+        /**
+         * Get the marbles in each hole at the opening the book was built
+         * from.
+         *
+         * @return The marble count, or 0 if the book is empty.
+         */
+        uint8_t get_n_marbles() const;
+
+        /**
+         * Get the number of positions in the book.
+         *
+         * @return The number of positions.
+         */
+        size_t size() const;
+
+    private:
+        OpeningBook(const OpeningBook &);
+        OpeningBook &operator=(const OpeningBook &);
+
+        /**
+         * Unmap the mapped file, if any.
+         */
+        void unmap();
+
+        /**
+         * The mapped file, or NULL.
+         */
+        const uint8_t *mapping;
+
+        /**
+         * The size of the mapped file.
+         */
+        size_t mapping_size;
+
+        /**
+         * The entries, in the mapping.
+         */
+        const BookEntry *entries;
+
+        /**
+         * The number of entries.
+         */
+        size_t n_entries;
+
+        /**
+         * The marbles in each hole at the opening.
+         */
+        uint8_t n_marbles;
+    };
+}
@@ -0,0 +1,82 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A small, fast random number generator for playouts and
+ *        self-play.
+ */
+
+#pragma once
+
+#include "move_set.h"
+
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A xorshift64* generator. It holds one word of state, so every thread
+     * can keep its own and never share one.
+     */
+    class Random
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param seed Any value. Different seeds give unrelated streams.
+         */
+        explicit Random(uint64_t seed = 0u)
+        {
+            /*
+             * One round of splitmix64, so that nearby seeds start far
+             * apart. The state must never be zero.
+             */
+            seed += 0x9E3779B97F4A7C15ull;
+            seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+            state = (seed ^ (seed >> 31)) | 1u;
+        }
+
+        /**
+         * Get the next number.
+         *
+         * @return 64 random bits.
+         */
+        uint64_t next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+
+            return state * 0x2545F4914F6CDD1Dull;
+        }
+
+        /**
+         * Pick one of a set of rows at random.
+         *
+         * @param moves The rows to pick from. Must not be empty.
+         *
+         * @return The row picked.
+         */
+        uint8_t pick(const MoveSet moves)
+        {
+            uint8_t mask = moves.mask();
+            uint32_t skip = static_cast<uint32_t>(((next() >> 32) * moves.size()) >> 32);
+
+            while (skip-- != 0)
+            {
+                mask &= static_cast<uint8_t>(mask - 1u);
+            }
+
+            return static_cast<uint8_t>(__builtin_ctz(mask));
+        }
+
+    private:
+        /**
+         * The generator's state.
+         */
+        uint64_t state;
+    };
+}
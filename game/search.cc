@@ -0,0 +1,403 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An alpha-beta search engine for a computer opponent.
+ */
+
+#include "search.h"
+#include "sowing.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A score beyond any reachable marble difference.
+     */
+    static const int16_t infinity = 1000;
+
+    /**
+     * How often, in nodes, the clock is checked.
+     */
+    static const uint64_t clock_interval = 1024u;
+
+    /**
+     * Get the other side of the board.
+     */
+    static inline Side other_side(const Side side)
+    {
+        return side == Side::A ? Side::B : Side::A;
+    }
+
+    /**
+     * Check if a move's result gives the mover another turn.
+     */
+    static inline bool moves_again(const GameState result, const Side side)
+    {
+        return result == (side == Side::A ? GameState::SideA : GameState::SideB);
+    }
+
+    Search::Search(TranspositionTable *_table) :
+        table(_table),
+        endgame(NULL),
+        book(NULL),
+        nodes(0),
+        stopped(false),
+        time_ms(0),
+        halt(NULL)
+    {
+    }
+
+    int16_t Search::evaluate(const BoardState &state, Side side)
+    {
+        return static_cast<int16_t>(state.get_home(side)) -
+            static_cast<int16_t>(state.get_home(other_side(side)));
+    }
+
+    uint8_t Search::order_moves(const BoardState &state, Side side,
+        uint8_t first, uint8_t rows[BoardState::n_rows])
+    {
+        const MoveSet legal = state.legal_moves(side);
+        uint8_t n_rows = 0;
+
+        if (legal.contains(first))
+        {
+            rows[n_rows++] = first;
+        }
+
+        /*
+         * Moves that end at home (and so move again) go first, then the
+         * rest, nearest to home first. A's home is past row 5, and B's is
+         * before row 0.
+         */
+        for (uint8_t pass = 0; pass < 2; pass++)
+        {
+            for (uint8_t step = 0; step < BoardState::n_rows; step++)
+            {
+                const uint8_t row = side == Side::A ?
+                    static_cast<uint8_t>(BoardState::n_rows - 1u - step) : step;
+                const uint8_t to_home = side == Side::A ?
+                    static_cast<uint8_t>(BoardState::n_rows - row) : static_cast<uint8_t>(row + 1u);
+                const bool again = state.get_hole(side, row) % (BoardState::n_pits - 1u) == to_home;
+
+                if (legal.contains(row) && row != first && again == (pass == 0))
+                {
+                    rows[n_rows++] = row;
+                }
+            }
+        }
+
+        return n_rows;
+    }
+
+    void Search::set_endgame(const EndgameDatabase *_endgame)
+    {
+        endgame = _endgame;
+    }
+
+    void Search::set_book(const OpeningBook *_book)
+    {
+        book = _book;
+    }
+
+    bool Search::out_of_time()
+    {
+        if (halt != NULL && halt->load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        if (time_ms == 0)
+        {
+            return false;
+        }
+
+        const std::chrono::steady_clock::duration elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= time_ms;
+    }
+
+    int16_t Search::negamax(const BoardState &state, Side side, uint8_t depth,
+        int16_t alpha, int16_t beta)
+    {
+        nodes++;
+
+        if (nodes % clock_interval == 0 && out_of_time())
+        {
+            stopped = true;
+        }
+
+        if (stopped)
+        {
+            return 0;
+        }
+
+        int16_t future;
+
+        if (endgame != NULL && endgame->probe(state, side, future))
+        {
+            return evaluate(state, side) + future;
+        }
+
+        if (depth == 0)
+        {
+            return evaluate(state, side);
+        }
+
+        const int16_t alpha_in = alpha;
+        uint64_t key = 0;
+        uint8_t first = 0xFF;
+
+        const bool use_table = table != NULL && depth > 1u;
+
+        if (use_table)
+        {
+            key = state.key(side);
+
+            TableEntry entry;
+
+            if (table->probe(key, entry))
+            {
+                first = entry.row;
+
+                if (entry.depth >= depth &&
+                    (entry.bound == Bound::ExactBound ||
+                    (entry.bound == Bound::LowerBound && entry.score >= beta) ||
+                    (entry.bound == Bound::UpperBound && entry.score <= alpha)))
+                {
+                    return entry.score;
+                }
+            }
+        }
+
+        uint8_t rows[BoardState::n_rows];
+        const uint8_t n_rows = order_moves(state, side, first, rows);
+
+        int16_t best = -infinity;
+        uint8_t best_row = 0xFF;
+
+        for (uint8_t i = 0; i < n_rows; i++)
+        {
+            BoardState child = state;
+            const GameState result = apply_move(child, side, rows[i]);
+            int16_t score;
+
+            if (result == GameState::GameOver)
+            {
+                score = evaluate(child, side);
+            }
+            else if (moves_again(result, side))
+            {
+                score = negamax(child, side, depth - 1u, alpha, beta);
+            }
+            else
+            {
+                score = -negamax(child, other_side(side), depth - 1u, -beta, -alpha);
+            }
+
+            if (score > best)
+            {
+                best = score;
+                best_row = rows[i];
+
+                if (score > alpha)
+                {
+                    alpha = score;
+
+                    if (alpha >= beta)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (use_table && !stopped)
+        {
+            TableEntry entry;
+            entry.row = best_row;
+            entry.score = best;
+            entry.depth = depth;
+            entry.bound = best <= alpha_in ? Bound::UpperBound :
+                best >= beta ? Bound::LowerBound : Bound::ExactBound;
+
+            table->store(key, entry);
+        }
+
+        return best;
+    }
+
+    SearchResult Search::think(const BoardState &state, Side side,
+        const SearchLimits &limits)
+    {
+        start = std::chrono::steady_clock::now();
+        time_ms = limits.time_ms;
+
+        BookEntry entry;
+
+        if (book != NULL && book->probe(state, side, entry))
+        {
+            SearchResult result;
+            result.row = entry.row;
+            result.score = entry.value;
+            result.depth = 0;
+            result.nodes = 0;
+            result.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+            return result;
+        }
+
+        if (table != NULL)
+        {
+            table->new_search();
+        }
+
+        if (limits.threads <= 1u || table == NULL)
+        {
+            SearchResult result = deepen(state, side, limits.depth, 0);
+            result.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+            return result;
+        }
+
+        /*
+         * Lazy SMP: helper threads search the same position with no
+         * coordination other than the shared table, which they fill with
+         * results the main thread then finds. Half of the helpers search a
+         * ply deeper, and each helper tries the root moves in a different
+         * order, so they tend to work ahead of the main thread rather than
+         * repeat it. Only the main thread's result is used.
+         */
+        std::atomic<bool> done(false);
+        std::vector<Search> helpers(limits.threads - 1u, *this);
+        std::vector<std::thread> workers;
+
+        for (uint8_t i = 0; i < helpers.size(); i++)
+        {
+            helpers[i].start = start;
+            helpers[i].time_ms = 0;
+            helpers[i].halt = &done;
+
+            workers.push_back(std::thread(&Search::deepen, &helpers[i],
+                std::cref(state), side, limits.depth, static_cast<uint8_t>(i + 1u)));
+        }
+
+        SearchResult result = deepen(state, side, limits.depth, 0);
+
+        done.store(true, std::memory_order_relaxed);
+
+        for (uint8_t i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+            result.nodes += helpers[i].nodes;
+        }
+
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+
+    SearchResult Search::deepen(const BoardState &state, Side side,
+        uint8_t max_depth, uint8_t helper)
+    {
+        nodes = 0;
+        stopped = false;
+
+        SearchResult result;
+        result.row = 0xFF;
+        result.score = 0;
+        result.depth = 0;
+
+        const MoveSet legal = state.legal_moves(side);
+
+        if (!legal.empty())
+        {
+            result.row = *legal.begin();
+        }
+
+        for (uint8_t depth = 1u + (helper & 1u);
+            depth <= max_depth + (helper & 1u) && !legal.empty(); depth++)
+        {
+            uint8_t rows[BoardState::n_rows];
+            const uint8_t n_rows = order_moves(state, side, result.row, rows);
+
+            int16_t alpha = -infinity;
+            uint8_t best_row = rows[0];
+
+            for (uint8_t j = 0; j < n_rows; j++)
+            {
+                const uint8_t row = rows[(j + helper) % n_rows];
+                BoardState child = state;
+                const GameState result_code = apply_move(child, side, row);
+                int16_t score;
+
+                if (result_code == GameState::GameOver)
+                {
+                    score = evaluate(child, side);
+                }
+                else if (moves_again(result_code, side))
+                {
+                    score = negamax(child, side, depth - 1u, alpha, infinity);
+                }
+                else
+                {
+                    score = -negamax(child, other_side(side), depth - 1u, -infinity, -alpha);
+                }
+
+                if (stopped)
+                {
+                    break;
+                }
+
+                if (score > alpha)
+                {
+                    alpha = score;
+                    best_row = row;
+                }
+            }
+
+            /*
+             * An iteration cut short by the clock is thrown away.
+             */
+            if (stopped)
+            {
+                break;
+            }
+
+            result.row = best_row;
+            result.score = alpha;
+            result.depth = depth;
+
+            /*
+             * Another iteration would almost certainly not finish in the
+             * time left.
+             */
+            if (time_ms != 0)
+            {
+                const std::chrono::steady_clock::duration elapsed =
+                    std::chrono::steady_clock::now() - start;
+
+                if (std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() * 2 >= time_ms)
+                {
+                    break;
+                }
+            }
+        }
+
+        result.nodes = nodes;
+        result.seconds = 0.0;
+
+        return result;
+    }
+}
@@ -0,0 +1,247 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An alpha-beta search engine for a computer opponent.
+ */
+
+#pragma once
+
+#include "board_state.h"
+#include "endgame_db.h"
+#include "opening_book.h"
+#include "transposition_table.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * When a search should stop.
+     */
+    struct SearchLimits
+    {
+        SearchLimits() : depth(max_depth), time_ms(0), threads(1)
+        {
+        }
+
+        /**
+         * The deepest search allowed, in plies.
+         */
+        static const uint8_t max_depth = 96u;
+
+        /**
+         * The deepest iteration to search, in plies.
+         */
+        uint8_t depth;
+
+        /**
+         * The time budget for the move in milliseconds, 0 for none.
+         */
+        uint32_t time_ms;
+
+        /**
+         * The number of threads to search with. More than one thread is
+         * only used by searches with a transposition table.
+         */
+        uint8_t threads;
+    };
+
+    /**
+     * The outcome of a search.
+     */
+    struct SearchResult
+    {
+        /**
+         * The best row found, or 0xFF if the side has no moves.
+         */
+        uint8_t row;
+
+        /**
+         * The score of the best row: the marbles the side to move is
+         * expected to finish ahead by.
+         */
+        int16_t score;
+
+        /**
+         * The deepest iteration completed, 0 for a book move.
+         */
+        uint8_t depth;
+
+        /**
+         * The number of positions visited, by all threads.
+         */
+        uint64_t nodes;
+
+        /**
+         * The time spent searching in seconds.
+         */
+        double seconds;
+    };
+
+    /**
+     * A negamax alpha-beta search with iterative deepening.
+     *
+     * Scores are from the point of view of the side to move, counted in
+     * marbles: the difference between the two homes at the leaves, and
+     * the final difference once the game is over. A move that ends in the
+     * mover's home is followed by another move of the same side, and its
+     * score is not negated.
+     *
+     * Searches given a transposition table store every searched position
+     * in it, and use it to skip positions already searched deeply enough
+     * and to try the best move found before first. Scores only depend on
+     * the position (the homes are part of it), never on the path to it, so
+     * they can be shared between transpositions as they are.
+     *
+     * Positions found in an endgame database, if one is given, are scored
+     * exactly without searching them. A position found in an opening book,
+     * if one is given, is not searched at all: its book move is played.
+     *
+     * A search can also run on several threads sharing its table (Lazy
+     * SMP); see SearchLimits::threads.
+     */
+    class Search
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param _table The transposition table to use, or NULL for none.
+         *        The table is not owned by the search.
+         */
+        explicit Search(TranspositionTable *_table = NULL);
+
+        /**
+         * Find the best move for a side.
+         *
+         * @param state The position to search.
+         * @param side The side to move.
+         * @param limits When to stop searching.
+         *
+         * @return The best move found by the deepest completed iteration.
+         */
+        SearchResult think(const BoardState &state, Side side,
+            const SearchLimits &limits);
+
+        /**
+         * Set the endgame database to probe.
+         *
+         * @param _endgame The database, or NULL for none. The database is
+         *        not owned by the search.
+         */
+        void set_endgame(const EndgameDatabase *_endgame);
+
+        /**
+         * Set the opening book to probe before searching.
+         *
+         * @param _book The book, or NULL for none. The book is not owned
+         *        by the search.
+         */
+        void set_book(const OpeningBook *_book);
+
+        /**
+         * Score a position from the side to move's point of view.
+         *
+         * @param state The position to score.
+         * @param side The side to move.
+         *
+         * @return The difference between the two homes.
+         */
+        static int16_t evaluate(const BoardState &state, Side side);
+
+        /**
+         * Order a side's moves, most promising first.
+         *
+         * @param state The position to move in.
+         * @param side The side to move.
+         * @param first A row to try before any other, or 0xFF.
+         * @param[out] rows The rows to try, in order.
+         *
+         * @return The number of rows.
+         */
+        static uint8_t order_moves(const BoardState &state, Side side,
+            uint8_t first, uint8_t rows[BoardState::n_rows]);
+
+    private:
+        /**
+         * Search a position one ply deeper at a time, until the deepest
+         * iteration is done or the search is stopped.
+         *
+         * @param state The position to search.
+         * @param side The side to move.
+         * @param max_depth The deepest iteration to search.
+         * @param helper 0 for the main thread, or the helper thread's
+         *        number, which varies the depths and move order searched.
+         *
+         * @return The best move found by the deepest completed iteration.
+         */
+        SearchResult deepen(const BoardState &state, Side side,
+            uint8_t max_depth, uint8_t helper);
+
+        /**
+         * Search a position to a fixed depth.
+         *
+         * @param state The position to search.
+         * @param side The side to move.
+         * @param depth The number of plies left to search.
+         * @param alpha The score the side to move is already assured of.
+         * @param beta The score the opponent is already assured of.
+         *
+         * @return The score of the position.
+         */
+        int16_t negamax(const BoardState &state, Side side, uint8_t depth,
+            int16_t alpha, int16_t beta);
+
+        /**
+         * Check if the time budget has run out.
+         *
+         * @return True if the search should stop.
+         */
+        bool out_of_time();
+
+        /**
+         * The transposition table, or NULL.
+         */
+        TranspositionTable *table;
+
+        /**
+         * The endgame database, or NULL.
+         */
+        const EndgameDatabase *endgame;
+
+        /**
+         * The opening book, or NULL.
+         */
+        const OpeningBook *book;
+
+        /**
+         * The number of positions visited in this search.
+         */
+        uint64_t nodes;
+
+        /**
+         * Set once the search has run out of time.
+         */
+        bool stopped;
+
+        /**
+         * The time budget for this search, 0 for none.
+         */
+        uint32_t time_ms;
+
+        /**
+         * When the search started.
+         */
+        std::chrono::steady_clock::time_point start;
+
+        /**
+         * Set by the main thread to stop a helper thread, or NULL.
+         */
+        const std::atomic<bool> *halt;
+    };
+}
@@ -0,0 +1,283 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Generate self-play games on every core and stream them to a file.
+ */
+
+#include "self_play.h"
+#include "sowing.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * The records each playing thread can have waiting for the writer.
+     */
+    static const size_t queue_records = 4096u;
+
+    /**
+     * The most records written between checks on the time, for progress
+     * reports.
+     */
+    static const size_t drain_records = 256u;
+
+    /**
+     * One playing thread.
+     */
+    struct SelfPlayWorker
+    {
+        SelfPlayWorker() :
+            queue(queue_records), dropped(0), finished(false)
+        {
+        }
+
+        /**
+         * The records played and not yet written.
+         */
+        SpscQueue<GameRecord> queue;
+
+        /**
+         * The games dropped, written by this thread only.
+         */
+        std::atomic<uint64_t> dropped;
+
+        /**
+         * Set once the thread has published its last record.
+         */
+        std::atomic<bool> finished;
+    };
+
+    /**
+     * Play a thread's share of the games.
+     */
+    static void play_games(SelfPlayWorker *worker, const uint8_t n_marbles,
+        const uint64_t seed, const uint64_t n_games, const std::atomic<bool> *halt)
+    {
+        Random random(seed);
+
+        for (uint64_t i = 0; i < n_games && !halt->load(std::memory_order_relaxed); i++)
+        {
+            GameRecord *record;
+
+            while ((record = worker->queue.claim()) == NULL)
+            {
+                if (halt->load(std::memory_order_relaxed))
+                {
+                    worker->finished.store(true, std::memory_order_release);
+                    return;
+                }
+
+                std::this_thread::yield();
+            }
+
+            if (SelfPlay::play(n_marbles, random, *record))
+            {
+                worker->queue.publish();
+            }
+            else
+            {
+                worker->dropped.store(worker->dropped.load(std::memory_order_relaxed) + 1u,
+                    std::memory_order_relaxed);
+            }
+        }
+
+        worker->finished.store(true, std::memory_order_release);
+    }
+
+    SelfPlay::SelfPlay(uint8_t _n_marbles, uint8_t _threads, uint64_t _seed) :
+        n_marbles(_n_marbles),
+        threads(_threads),
+        seed(_seed)
+    {
+    }
+
+    bool SelfPlay::play(uint8_t n_marbles, Random &random, GameRecord &record)
+    {
+        BoardState state = BoardState::initial(n_marbles);
+        Side side = Side::A;
+
+        record.n_marbles = n_marbles;
+        record.n_moves = 0;
+
+        while (true)
+        {
+            if (record.n_moves == GameRecord::max_moves)
+            {
+                return false;
+            }
+
+            const uint8_t row = random.pick(state.legal_moves(side));
+            const GameState result = apply_move(state, side, row);
+
+            record.rows[record.n_moves++] = row;
+
+            if (result == GameState::GameOver)
+            {
+                break;
+            }
+
+            side = result == GameState::SideA ? Side::A : Side::B;
+        }
+
+        record.margin = static_cast<int8_t>(state.get_home(Side::A) - state.get_home(Side::B));
+
+        return true;
+    }
+
+    bool SelfPlay::run(const char *path, uint64_t n_games,
+        bool (*progress)(const SelfPlayStats &stats, void *context),
+        void *context, uint32_t interval_ms)
+    {
+        if (n_marbles == 0 || n_marbles > max_marbles || threads == 0)
+        {
+            return false;
+        }
+
+        GameRecordWriter writer;
+
+        if (!writer.open(path, n_marbles))
+        {
+            return false;
+        }
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point report = start;
+
+        std::atomic<bool> halt(false);
+        std::unique_ptr<SelfPlayWorker[]> workers(new SelfPlayWorker[threads]);
+        std::vector<std::thread> players;
+
+        for (uint8_t i = 0; i < threads; i++)
+        {
+            const uint64_t share = n_games / threads + (i < n_games % threads ? 1u : 0u);
+
+            players.push_back(std::thread(play_games, &workers[i], n_marbles,
+                seed * threads + i, share, &halt));
+        }
+
+        SelfPlayStats stats;
+        stats.games = 0;
+        stats.moves = 0;
+        stats.dropped = 0;
+        stats.bytes = writer.size();
+        stats.seconds = 0.0;
+
+        bool written = true;
+
+        /*
+         * Game i of the file is the next record of queue i % threads,
+         * skipping the queues of threads with no games left, so that the
+         * file depends only on the seed and the number of threads, not on
+         * how the threads were scheduled.
+         */
+        std::vector<bool> exhausted(threads, false);
+        uint8_t remaining = threads;
+        uint8_t next = 0;
+
+        while (remaining > 0)
+        {
+            bool idle = true;
+
+            for (size_t n = 0; n < drain_records && remaining > 0; n++)
+            {
+                SelfPlayWorker &worker = workers[next];
+
+                /*
+                 * A queue is only known to be empty for good if its thread
+                 * had finished before it was found empty.
+                 */
+                const bool finished = worker.finished.load(std::memory_order_acquire);
+                const GameRecord *record = worker.queue.peek();
+
+                if (record != NULL)
+                {
+                    if (written && !writer.write(*record))
+                    {
+                        written = false;
+                        halt.store(true, std::memory_order_relaxed);
+                    }
+
+                    stats.games++;
+                    stats.moves += record->n_moves;
+                    worker.queue.release();
+                    idle = false;
+                }
+                else if (finished)
+                {
+                    exhausted[next] = true;
+                    remaining--;
+                }
+                else
+                {
+                    break;
+                }
+
+                do
+                {
+                    next = static_cast<uint8_t>((next + 1u) % threads);
+                } while (remaining > 0 && exhausted[next]);
+            }
+
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+            if (progress != NULL &&
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - report).count() >= interval_ms)
+            {
+                report = now;
+                stats.bytes = writer.size();
+                stats.seconds = std::chrono::duration<double>(now - start).count();
+                stats.dropped = 0;
+
+                for (uint8_t i = 0; i < threads; i++)
+                {
+                    stats.dropped += workers[i].dropped.load(std::memory_order_relaxed);
+                }
+
+                if (!progress(stats, context))
+                {
+                    halt.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            if (idle)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        for (uint8_t i = 0; i < threads; i++)
+        {
+            players[i].join();
+        }
+
+        written = writer.close() && written;
+
+        stats.bytes = writer.size();
+        stats.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        stats.dropped = 0;
+
+        for (uint8_t i = 0; i < threads; i++)
+        {
+            stats.dropped += workers[i].dropped.load(std::memory_order_relaxed);
+        }
+
+        if (progress != NULL)
+        {
+            progress(stats, context);
+        }
+
+        return written && !halt.load(std::memory_order_relaxed);
+    }
+}
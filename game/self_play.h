@@ -0,0 +1,129 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Generate self-play games on every core and stream them to a file.
+ */
+
+#pragma once
+
+#include "game_record.h"
+#include "random.h"
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * How far a self-play run has got.
+     */
+    struct SelfPlayStats
+    {
+        /**
+         * The number of games written.
+         */
+        uint64_t games;
+
+        /**
+         * The number of moves in the games written.
+         */
+        uint64_t moves;
+
+        /**
+         * The number of games thrown away for being longer than a record
+         * can hold.
+         */
+        uint64_t dropped;
+
+        /**
+         * The number of bytes written.
+         */
+        uint64_t bytes;
+
+        /**
+         * The time since the run started in seconds.
+         */
+        double seconds;
+    };
+
+    /**
+     * Plays games with random moves on any number of threads, and writes
+     * them all to one file.
+     *
+     * The playing threads share no mutable state: each has its own random
+     * numbers, its own share of the games and its own lock-free queue to
+     * the writing thread, and fills its records in place in the queue. The
+     * writing thread takes one record from each queue in turn and writes
+     * them out through GameRecordWriter's buffer, so the file's order does
+     * not depend on how the threads were scheduled. A playing thread only
+     * ever waits when the writer falls behind and its queue is full.
+     */
+    class SelfPlay
+    {
+
+    public:
+        /**
+         * The most marbles in each hole a game can start with, so that
+         * the final margin fits a record.
+         */
+        static const uint8_t max_marbles = 10u;
+
+        /**
+         * Constructor.
+         *
+         * @param _n_marbles The marbles in each hole at the opening.
+         * @param _threads The number of threads playing games.
+         * @param _seed The seed the threads' random numbers are drawn
+         *        from. The same seed and threads give the same file,
+         *        unless the run is stopped early.
+         */
+        SelfPlay(uint8_t _n_marbles = 4u, uint8_t _threads = 1u,
+            uint64_t _seed = 0u);
+
+        /**
+         * Play games and write them to a file. The calling thread writes.
+         *
+         * @param path The file to create.
+         * @param n_games The number of games to play.
+         * @param progress Called about every interval_ms, and once at the
+         *        end. Returning false stops the run early, keeping the
+         *        games played so far. May be NULL.
+         * @param context Passed to progress.
+         * @param interval_ms The time between calls to progress.
+         *
+         * @return True unless the run was stopped early or a write
+         *         failed.
+         */
+        bool run(const char *path, uint64_t n_games,
+            bool (*progress)(const SelfPlayStats &stats, void *context),
+            void *context, uint32_t interval_ms = 1000u);
+
+        /**
+         * Play one game from the opening with random moves.
+         *
+         * @param n_marbles The marbles in each hole at the opening.
+         * @param random The random numbers to play with.
+         * @param[out] record The game.
+         *
+         * @return False if the game was longer than a record can hold.
+         */
+        static bool play(uint8_t n_marbles, Random &random, GameRecord &record);
+
+    private:
+        /**
+         * The marbles in each hole at the opening.
+         */
+        uint8_t n_marbles;
+
+        /**
+         * The number of threads playing games.
+         */
+        uint8_t threads;
+
+        /**
+         * The seed of the threads' random numbers.
+         */
+        uint64_t seed;
+    };
+}
@@ -0,0 +1,296 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An exact solver for mancala positions, and the file its proven
+ *        values are kept in.
+ */
+
+#include "solver.h"
+#include "search.h"
+#include "sowing.h"
+#include "zobrist.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace Mancala
+{
+    /**
+     * A value beyond any reachable gain.
+     */
+    static const int16_t infinity = 1000;
+
+    /**
+     * The depth table entries are stored at: searched to the end of the
+     * game.
+     */
+    static const uint8_t solved_depth = 0xFF;
+
+    /**
+     * The solution file header.
+     */
+    struct SolutionHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t record_size;
+    };
+
+    static const char solution_magic[8] = {'M', 'N', 'C', 'L', 'S', 'O', 'L', 'V'};
+    static const uint32_t solution_version = 1u;
+
+    static_assert(sizeof(SolvedPosition) == 16u,
+        "Solution records must be 16 bytes");
+
+    Solver::Solver(TranspositionTable &_table, const EndgameDatabase *_endgame) :
+        table(_table),
+        endgame(_endgame),
+        nodes(0)
+    {
+    }
+
+    uint64_t Solver::key(const BoardState &state, Side side)
+    {
+        /*
+         * The key of the same holes with both homes empty.
+         */
+        return state.key(side) ^
+            Zobrist::pit_delta(BoardState::home(Side::A), state.get_home(Side::A), 0u) ^
+            Zobrist::pit_delta(BoardState::home(Side::B), state.get_home(Side::B), 0u);
+    }
+
+    uint64_t Solver::get_nodes() const
+    {
+        return nodes;
+    }
+
+    int16_t Solver::solve(const BoardState &state, Side side, int16_t guess)
+    {
+        int16_t value = guess;
+        int16_t lower = -infinity;
+        int16_t upper = infinity;
+
+        while (lower < upper)
+        {
+            const int16_t beta = value == lower ? value + 1 : value;
+
+            value = search(state, side, beta - 1, beta);
+
+            if (value < beta)
+            {
+                upper = value;
+            }
+            else
+            {
+                lower = value;
+            }
+        }
+
+        return value;
+    }
+
+    int16_t Solver::search(const BoardState &state, Side side, int16_t alpha,
+        int16_t beta)
+    {
+        nodes++;
+
+        int16_t future;
+
+        if (endgame != NULL && endgame->probe(state, side, future))
+        {
+            return future;
+        }
+
+        const Side other = side == Side::A ? Side::B : Side::A;
+        const MoveSet legal = state.legal_moves(side);
+
+        /*
+         * A side with no moves means the game is over, and each side
+         * sweeps its own holes.
+         */
+        if (legal.empty() || state.legal_moves(other).empty())
+        {
+            int16_t own = 0;
+
+            for (uint8_t row = 0; row < BoardState::n_rows; row++)
+            {
+                own += state.get_hole(side, row);
+                own -= state.get_hole(other, row);
+            }
+
+            return own;
+        }
+
+        const uint64_t position_key = key(state, side);
+        const int16_t alpha_in = alpha;
+        uint8_t first = 0xFF;
+
+        TableEntry entry;
+
+        if (table.probe(position_key, entry) && entry.depth == solved_depth)
+        {
+            first = entry.row;
+
+            if (entry.bound == Bound::ExactBound ||
+                (entry.bound == Bound::LowerBound && entry.score >= beta) ||
+                (entry.bound == Bound::UpperBound && entry.score <= alpha))
+            {
+                return entry.score;
+            }
+        }
+
+        uint8_t rows[BoardState::n_rows];
+        const uint8_t n_rows = Search::order_moves(state, side, first, rows);
+
+        int16_t best = -infinity;
+        uint8_t best_row = 0xFF;
+
+        for (uint8_t i = 0; i < n_rows; i++)
+        {
+            BoardState child = state;
+            const GameState result = apply_move(child, side, rows[i]);
+
+            const int16_t gain =
+                (static_cast<int16_t>(child.get_home(side)) - state.get_home(side)) -
+                (static_cast<int16_t>(child.get_home(other)) - state.get_home(other));
+
+            int16_t score;
+
+            if (result == GameState::GameOver)
+            {
+                score = gain;
+            }
+            else if (result == (side == Side::A ? GameState::SideA : GameState::SideB))
+            {
+                score = gain + search(child, side, alpha - gain, beta - gain);
+            }
+            else
+            {
+                score = gain - search(child, other, gain - beta, gain - alpha);
+            }
+
+            if (score > best)
+            {
+                best = score;
+                best_row = rows[i];
+
+                if (score > alpha)
+                {
+                    alpha = score;
+
+                    if (alpha >= beta)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        entry.row = best_row;
+        entry.score = best;
+        entry.depth = solved_depth;
+        entry.bound = best <= alpha_in ? Bound::UpperBound :
+            best >= beta ? Bound::LowerBound : Bound::ExactBound;
+
+        table.store(position_key, entry);
+
+        return best;
+    }
+
+    SolutionFile::SolutionFile() : file(NULL)
+    {
+    }
+
+    SolutionFile::~SolutionFile()
+    {
+        close();
+    }
+
+    bool SolutionFile::open(const char *path,
+        void (*handle)(const SolvedPosition &record, void *context),
+        void *context)
+    {
+        close();
+
+        SolutionHeader header;
+        file = fopen(path, "r+b");
+
+        if (file == NULL)
+        {
+            file = fopen(path, "w+b");
+
+            if (file == NULL)
+            {
+                return false;
+            }
+
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, solution_magic, sizeof(header.magic));
+            header.version = solution_version;
+            header.record_size = sizeof(SolvedPosition);
+
+            if (fwrite(&header, sizeof(header), 1, file) != 1 || !checkpoint())
+            {
+                close();
+                return false;
+            }
+
+            return true;
+        }
+
+        if (fread(&header, sizeof(header), 1, file) != 1 ||
+            memcmp(header.magic, solution_magic, sizeof(header.magic)) != 0 ||
+            header.version != solution_version ||
+            header.record_size != sizeof(SolvedPosition))
+        {
+            close();
+            return false;
+        }
+
+        SolvedPosition record;
+        long length = sizeof(header);
+
+        while (fread(&record, sizeof(record), 1, file) == 1)
+        {
+            handle(record, context);
+            length += sizeof(record);
+        }
+
+        /*
+         * Drop a record cut short, then append after the last whole one.
+         */
+        if (fflush(file) != 0 || ftruncate(fileno(file), length) != 0 ||
+            fseek(file, length, SEEK_SET) != 0)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SolutionFile::append(const SolvedPosition &record)
+    {
+        return file != NULL && fwrite(&record, sizeof(record), 1, file) == 1;
+    }
+
+    bool SolutionFile::checkpoint()
+    {
+        return file != NULL && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    }
+
+    void SolutionFile::close()
+    {
+        if (file != NULL)
+        {
+            checkpoint();
+            fclose(file);
+            file = NULL;
+        }
+    }
+}
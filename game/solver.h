@@ -0,0 +1,207 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An exact solver for mancala positions, and the file its proven
+ *        values are kept in.
+ */
+
+#pragma once
+
+#include "board_state.h"
+#include "endgame_db.h"
+#include "transposition_table.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+
+namespace Mancala
+{
+    /**
+     * Proves the value of positions by searching them to the end of the
+     * game.
+     *
+     * Values are those of the endgame database: what the side to move
+     * will gain over the other side from here on. They do not depend on
+     * the homes, so positions are keyed by their holes and the side to
+     * move alone, and positions that only differ in their homes share
+     * their table entries. The final difference between the homes is the
+     * current difference plus the value.
+     *
+     * Each position is solved by MTD(f): a series of null-window
+     * alpha-beta searches, each proving the value is above or below a
+     * guess, until the bounds meet. Table entries are stored as proven to
+     * the end of the game, and the bounds they hold are reused between
+     * the searches of a series and between positions.
+     */
+    class Solver
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param _table The transposition table to use. It may be shared
+         *        with other solvers on other threads, but not with Search.
+         * @param _endgame An endgame database to end the search at, or
+         *        NULL for none.
+         */
+        Solver(TranspositionTable &_table, const EndgameDatabase *_endgame);
+
+        /**
+         * Prove the value of a position.
+         *
+         * @param state The position.
+         * @param side The side to move.
+         * @param guess A guess at the value. The closer, the fewer
+         *        searches needed.
+         *
+         * @return The marbles the side to move will gain over the other
+         *         side from here on, with best play by both.
+         */
+        int16_t solve(const BoardState &state, Side side, int16_t guess = 0);
+
+        /**
+         * Get the key positions are stored under: the key of the holes
+         * and the side to move, with the homes left out.
+         *
+         * @param state The position.
+         * @param side The side to move.
+         *
+         * @return The key.
+         */
+        static uint64_t key(const BoardState &state, Side side);
+
+        /**
+         * Get the number of positions visited since the solver was made.
+         *
+         * @return The number of positions.
+         */
+        uint64_t get_nodes() const;
+
+    private:
+        /**
+         * Search a position to the end of the game.
+         *
+         * @param state The position.
+         * @param side The side to move.
+         * @param alpha The value the side to move is already assured of.
+         * @param beta The value the other side is already assured of.
+         *
+         * @return The value if it lies between alpha and beta, otherwise
+         *         a bound on it on the side of the window it falls.
+         */
+        int16_t search(const BoardState &state, Side side, int16_t alpha,
+            int16_t beta);
+
+        /**
+         * The transposition table.
+         */
+        TranspositionTable &table;
+
+        /**
+         * The endgame database, or NULL.
+         */
+        const EndgameDatabase *endgame;
+
+        /**
+         * The number of positions visited.
+         */
+        uint64_t nodes;
+    };
+
+    /**
+     * A record of a proven position.
+     */
+    struct SolvedPosition
+    {
+        /**
+         * The position's key, from Solver::key.
+         */
+        uint64_t key;
+
+        /**
+         * The position's value, from Solver::solve.
+         */
+        int16_t value;
+
+        /**
+         * The number of moves from the position the solve started at.
+         */
+        uint16_t ply;
+
+        /**
+         * Zero.
+         */
+        uint32_t reserved;
+    };
+
+    /**
+     * An append-only file of proven positions, so that a long solve can be
+     * stopped and picked up where it left off.
+     *
+     * The file is a header and a run of fixed size records. Records are
+     * only ever appended, and are flushed to disk at each checkpoint, so
+     * a file cut short by a crash holds every record up to the last
+     * checkpoint and at most one partly written record, which is dropped
+     * when the file is reopened.
+     */
+    class SolutionFile
+    {
+
+    public:
+        /**
+         * Constructor.
+         */
+        SolutionFile();
+
+        /**
+         * Destructor. Checkpoints the file.
+         */
+        ~SolutionFile();
+
+        /**
+         * Open a solution file for appending, creating it if needed.
+         *
+         * @param path The file.
+         * @param handle Called once for every record already in the file.
+         * @param context Passed to handle.
+         *
+         * @return True on success.
+         */
+        bool open(const char *path,
+            void (*handle)(const SolvedPosition &record, void *context),
+            void *context);
+
+        /**
+         * Append a record.
+         *
+         * @param record The record.
+         *
+         * @return True on success.
+         */
+        bool append(const SolvedPosition &record);
+
+        /**
+         * Flush every appended record to disk.
+         *
+         * @return True on success.
+         */
+        bool checkpoint();
+
+        /**
+         * Close the file.
+         */
+        void close();
+
+    private:
+        SolutionFile(const SolutionFile &);
+        SolutionFile &operator=(const SolutionFile &);
+
+        /**
+         * The open file, or NULL.
+         */
+        FILE *file;
+    };
+}
@@ -0,0 +1,600 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The sowing kernel for mancala, run on a flat board state.
+ */
+
+#include "sowing.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * The SSE2 kernel is built for any x86 target, compiled for SSE2 on its
+ * own, and only run on CPUs that have it (see supported).
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define SOWING_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+ * The kernels treat the 16 byte state as two 64 bit words (or one 128 bit
+ * vector), one byte per pit, with pit 0 in the lowest byte.
+ */
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "the sowing kernel expects a little endian target"
+#endif
+
+namespace Mancala
+{
+    /**
+     * The number of pits a marble can land in during a move: every pit
+     * except the opponent's home.
+     */
+    static const uint8_t lap_length = BoardState::n_pits - 1u;
+
+    /**
+     * The pit following each pit (see Figure 2 in board_state.h) for
+     * each mover, skipping the opponent's home. Indexed by
+     * [side_index][pit].
+     */
+    static const uint8_t next_pit[2][BoardState::n_pits] =
+    {
+        {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0},
+        {1, 2, 3, 4, 5, 7, 7, 8, 9, 10, 11, 12, 13, 0}
+    };
+
+    /**
+     * Whether a pit is a non-home pit belonging to the mover. Indexed by
+     * [side_index][pit].
+     */
+    static const uint8_t own_pit[2][BoardState::n_pits] =
+    {
+        {1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0}
+    };
+
+    /**
+     * The pit across the board from each pit. Homes map to themselves so
+     * that a capture can be applied without branching.
+     */
+    static const uint8_t across_pit[BoardState::n_pits] =
+    {
+        12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 13
+    };
+
+    /**
+     * A byte for every pit of a state, packed into two words.
+     */
+    struct alignas(16) PitWords
+    {
+        uint64_t word[2];
+    };
+
+    /**
+     * Per move masks, built once by walking next_pit.
+     */
+    struct SowingTables
+    {
+        SowingTables()
+        {
+            memset(this, 0, sizeof(*this));
+
+            for (uint8_t s = 0; s < 2; s++)
+            {
+                const Side side = s == 0 ? Side::A : Side::B;
+
+                set(home_pit[s], BoardState::home(side));
+
+                for (uint8_t row = 0; row < BoardState::n_rows; row++)
+                {
+                    const uint8_t start = BoardState::pit(side, row);
+                    uint8_t pit = start;
+
+                    set(rows[s], start);
+                    set(start_pit[s][row], start);
+                    set(lap[s], start);
+                    landing[s][row][0] = start;
+
+                    for (uint8_t marbles = 1; marbles < lap_length; marbles++)
+                    {
+                        pit = next_pit[s][pit];
+
+                        set(lap[s], pit);
+                        landing[s][row][marbles] = pit;
+
+                        for (uint8_t more = marbles; more < lap_length; more++)
+                        {
+                            set(tail[s][row][more], pit, 1u);
+                        }
+                    }
+                }
+            }
+
+            for (uint8_t pit = 0; pit < BoardState::n_pits; pit++)
+            {
+                set(capture_pits[pit], pit);
+                set(capture_pits[pit], across_pit[pit]);
+            }
+        }
+
+        /**
+         * Set one pit's byte.
+         */
+        static void set(PitWords &words, const uint8_t pit,
+            const uint8_t value = 0xFF)
+        {
+            words.word[pit / 8u] |= static_cast<uint64_t>(value) << (8u * (pit % 8u));
+        }
+
+        /**
+         * 0xFF in every pit reached by a full lap. Indexed by
+         * [side_index].
+         */
+        PitWords lap[2];
+
+        /**
+         * 0xFF in each row of a side. Indexed by [side_index].
+         */
+        PitWords rows[2];
+
+        /**
+         * 0xFF in the home of a side. Indexed by [side_index].
+         */
+        PitWords home_pit[2];
+
+        /**
+         * 0xFF in the start pit of a move. Indexed by [side_index][row].
+         */
+        PitWords start_pit[2][BoardState::n_rows];
+
+        /**
+         * 0xFF in a pit and in the pit across from it. Indexed by [pit].
+         */
+        PitWords capture_pits[BoardState::n_pits];
+
+        /**
+         * One marble in each pit reached by the marbles left over after
+         * the full laps. Indexed by [side_index][row][marbles % 13].
+         */
+        PitWords tail[2][BoardState::n_rows][lap_length];
+
+        /**
+         * The pit the last marble lands in. Indexed by
+         * [side_index][row][marbles % 13].
+         */
+        uint8_t landing[2][BoardState::n_rows][lap_length];
+    };
+
+    /**
+     * Get the tables, built on first use so that moves can be played from
+     * static initializers in any translation unit.
+     */
+    static const SowingTables &sowing_tables()
+    {
+        static const SowingTables tables;
+
+        return tables;
+    }
+
+    /**
+     * What a sowing kernel reports back about a move.
+     */
+    struct Sown
+    {
+        /**
+         * The pit the last marble landed in.
+         */
+        uint8_t last;
+
+        /**
+         * True if the last marble captured the pit across from it.
+         */
+        bool captured;
+
+        /**
+         * The number of marbles taken from across the board on a capture.
+         */
+        uint8_t taken;
+
+        /**
+         * True if side A, or B, has no marbles left in its rows.
+         * @{
+         */
+        bool a_empty;
+        bool b_empty;
+        /**
+         * @}
+         */
+    };
+
+    /**
+     * A sowing kernel: sows a non-empty hole and applies any capture, but
+     * leaves the sweep at game over to the caller.
+     *
+     * @param[in,out] state The state to play on.
+     * @param s The side index of the mover.
+     * @param row The row to sow from.
+     * @param marbles The number of marbles in the hole.
+     *
+     * @return Where the move ended, and which sides are empty.
+     */
+    typedef Sown (*SowingKernel)(BoardState &state,
+        uint8_t s, uint8_t row, uint8_t marbles);
+
+    /**
+     * Row index into the tables above for a side.
+     */
+    static inline uint8_t side_index(const Side side)
+    {
+        return side == Side::A ? 0u : 1u;
+    }
+
+    /**
+     * Read one pit out of the words of a state.
+     */
+    static inline uint8_t get_pit(const uint64_t word[2], const uint8_t pit)
+    {
+        return static_cast<uint8_t>(word[pit / 8u] >> (8u * (pit % 8u)));
+    }
+
+    /**
+     * The portable kernel, run on two 64 bit words.
+     */
+    static Sown sow_scalar(BoardState &state,
+        const uint8_t s, const uint8_t row, const uint8_t marbles)
+    {
+        const SowingTables &tables = sowing_tables();
+
+        uint64_t word[2];
+        memcpy(word, state.pits, sizeof(word));
+
+        /*
+         * Empty the start pit, drop one marble in every pit but the
+         * opponent's home for each whole lap, then one marble each into
+         * the pits that follow the start for the rest. A pit never holds
+         * more than 255 marbles, so no byte carries into the next.
+         */
+        const uint8_t laps = marbles / lap_length;
+        const uint8_t remainder = marbles - laps * lap_length;
+        const uint64_t laps_bytes = laps * 0x0101010101010101ull;
+        const PitWords &start = tables.start_pit[s][row];
+        const PitWords &tail = tables.tail[s][row][remainder];
+
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            word[w] &= ~start.word[w];
+            word[w] += (laps_bytes & tables.lap[s].word[w]) + tail.word[w];
+        }
+
+        Sown sown;
+        sown.last = tables.landing[s][row][remainder];
+
+        /*
+         * The last marble landed in an empty hole on the mover's side:
+         * capture it along with the hole across the board.
+         */
+        const uint8_t across = across_pit[sown.last];
+        const uint64_t capture = own_pit[s][sown.last] & (get_pit(word, sown.last) == 1);
+        const uint64_t stolen = ((get_pit(word, across) + 1u) * capture) * 0x0101010101010101ull;
+        const PitWords &captured = tables.capture_pits[sown.last];
+
+        sown.captured = capture != 0;
+        sown.taken = get_pit(word, across);
+
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            word[w] &= ~(captured.word[w] & (0ull - capture));
+            word[w] += stolen & tables.home_pit[s].word[w];
+        }
+
+        sown.a_empty = ((word[0] & tables.rows[0].word[0]) |
+            (word[1] & tables.rows[0].word[1])) == 0;
+        sown.b_empty = ((word[0] & tables.rows[1].word[0]) |
+            (word[1] & tables.rows[1].word[1])) == 0;
+
+        memcpy(state.pits, word, sizeof(word));
+
+        return sown;
+    }
+
+#if defined(SOWING_SSE2)
+    /**
+     * Load a mask from the tables into a vector.
+     */
+    __attribute__((target("sse2")))
+    static inline __m128i load_mask(const PitWords &words)
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(words.word));
+    }
+
+    /**
+     * The SSE2 kernel: the whole move is one vector add.
+     */
+    __attribute__((target("sse2")))
+    static Sown sow_sse2(BoardState &state,
+        const uint8_t s, const uint8_t row, const uint8_t marbles)
+    {
+        const SowingTables &tables = sowing_tables();
+        const uint8_t laps = marbles / lap_length;
+        const uint8_t remainder = marbles - laps * lap_length;
+
+        __m128i pits = _mm_load_si128(reinterpret_cast<const __m128i *>(state.pits));
+
+        /*
+         * The increment for the whole move: laps in every pit but the
+         * opponent's home, plus the leftover marbles after the start.
+         */
+        const __m128i increment = _mm_add_epi8(
+            _mm_and_si128(_mm_set1_epi8(static_cast<char>(laps)), load_mask(tables.lap[s])),
+            load_mask(tables.tail[s][row][remainder]));
+
+        pits = _mm_add_epi8(_mm_andnot_si128(load_mask(tables.start_pit[s][row]), pits),
+            increment);
+
+        Sown sown;
+        sown.last = tables.landing[s][row][remainder];
+
+        /*
+         * A capture needs the last pit to hold only the marble that just
+         * landed in it, and takes the pit across from it.
+         */
+        const int singles = _mm_movemask_epi8(_mm_cmpeq_epi8(pits, _mm_set1_epi8(1)));
+        const uint8_t across = across_pit[sown.last];
+        const uint8_t capture = own_pit[s][sown.last] & (singles >> sown.last);
+
+        alignas(16) uint8_t counts[16];
+        _mm_store_si128(reinterpret_cast<__m128i *>(counts), pits);
+
+        sown.captured = capture != 0;
+        sown.taken = counts[across];
+
+        const uint8_t stolen = static_cast<uint8_t>((counts[across] + 1u) * capture);
+        const __m128i captured = _mm_and_si128(load_mask(tables.capture_pits[sown.last]),
+            _mm_set1_epi8(static_cast<char>(0u - capture)));
+        const __m128i home = _mm_and_si128(load_mask(tables.home_pit[s]),
+            _mm_set1_epi8(static_cast<char>(stolen)));
+
+        pits = _mm_add_epi8(_mm_andnot_si128(captured, pits), home);
+
+        /*
+         * Bits 0-5 are A0..A5, and bits 7-12 are B5..B0 (Figure 2).
+         */
+        const int empty = _mm_movemask_epi8(_mm_cmpeq_epi8(pits, _mm_setzero_si128()));
+
+        sown.a_empty = (empty & 0x003F) == 0x003F;
+        sown.b_empty = (empty & 0x1F80) == 0x1F80;
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(state.pits), pits);
+
+        return sown;
+    }
+#endif
+
+    /**
+     * Check if the CPU can run a kernel.
+     */
+    static bool supported(const SowingBackend backend)
+    {
+        switch (backend)
+        {
+            case SowingBackend::Scalar:
+                return true;
+
+            case SowingBackend::SSE2:
+#if defined(SOWING_SSE2)
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("sse2");
+#else
+                return false;
+#endif
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * The kernel for a backend.
+     */
+    static SowingKernel backend_kernel(const SowingBackend backend)
+    {
+#if defined(SOWING_SSE2)
+        if (backend == SowingBackend::SSE2)
+        {
+            return sow_sse2;
+        }
+#endif
+
+        return sow_scalar;
+    }
+
+    /**
+     * The kernel used by apply_move, and its backend.
+     */
+    struct SowingDispatch
+    {
+        /**
+         * Select the fastest kernel the CPU supports.
+         */
+        SowingDispatch() :
+            backend(supported(SowingBackend::SSE2) ? SowingBackend::SSE2 : SowingBackend::Scalar),
+            kernel(backend_kernel(backend))
+        {
+        }
+
+        SowingBackend backend;
+        SowingKernel kernel;
+    };
+
+    /**
+     * Get the kernel in use, selected on first use so that moves can be
+     * played from static initializers in any translation unit.
+     */
+    static SowingDispatch &sowing_dispatch()
+    {
+        static SowingDispatch dispatch;
+
+        return dispatch;
+    }
+
+    SowingBackend get_sowing_backend()
+    {
+        return sowing_dispatch().backend;
+    }
+
+    bool set_sowing_backend(SowingBackend backend)
+    {
+        if (!supported(backend))
+        {
+            return false;
+        }
+
+        sowing_dispatch().backend = backend;
+        sowing_dispatch().kernel = backend_kernel(backend);
+
+        return true;
+    }
+
+    /**
+     * Play a move, and optionally record how to take it back.
+     */
+    static inline GameState play(BoardState &state, const Side side,
+        const uint8_t row, MoveUndo *undo)
+    {
+        if (undo)
+        {
+            memset(undo, 0, sizeof(*undo));
+        }
+
+        if (row >= BoardState::n_rows)
+        {
+            return GameState::EmptyHoleError;
+        }
+
+        const uint8_t marbles = state.pits[BoardState::pit(side, row)];
+
+        if (marbles == 0)
+        {
+            return GameState::EmptyHoleError;
+        }
+
+        const Sown sown = sowing_dispatch().kernel(state, side_index(side), row, marbles);
+
+        if (undo)
+        {
+            undo->side = side;
+            undo->row = row;
+            undo->marbles = marbles;
+            undo->captured = sown.captured;
+            undo->taken = sown.taken;
+            undo->last = sown.last;
+        }
+
+        if (sown.a_empty || sown.b_empty)
+        {
+            /*
+             * The side that still has marbles keeps them. When both sides
+             * are empty this sweeps nothing.
+             */
+            const Side non_empty_side = sown.b_empty ? Side::A : Side::B;
+            uint8_t surplus_marbles = 0;
+
+            for (uint8_t r = 0; r < BoardState::n_rows; r++)
+            {
+                uint8_t &pit = state.pits[BoardState::pit(non_empty_side, r)];
+
+                if (undo)
+                {
+                    undo->swept[r] = pit;
+                }
+
+                surplus_marbles += pit;
+                pit = 0;
+            }
+
+            state.pits[BoardState::home(non_empty_side)] += surplus_marbles;
+
+            if (undo)
+            {
+                undo->game_over = true;
+                undo->swept_side = non_empty_side;
+            }
+
+            return GameState::GameOver;
+        }
+
+        /*
+         * Another turn if the last marble landed at home.
+         */
+        return (side == Side::A) == (sown.last == BoardState::home(side)) ?
+            GameState::SideA : GameState::SideB;
+    }
+
+    GameState apply_move(BoardState &state, Side side, uint8_t row)
+    {
+        return play(state, side, row, nullptr);
+    }
+
+    GameState make_move(BoardState &state, Side side, uint8_t row,
+        MoveUndo &undo)
+    {
+        return play(state, side, row, &undo);
+    }
+
+    void unmake_move(BoardState &state, const MoveUndo &undo)
+    {
+        if (undo.marbles == 0)
+        {
+            return;
+        }
+
+        const uint8_t s = side_index(undo.side);
+        const uint8_t home = BoardState::home(undo.side);
+
+        if (undo.game_over)
+        {
+            uint8_t surplus_marbles = 0;
+
+            for (uint8_t r = 0; r < BoardState::n_rows; r++)
+            {
+                state.pits[BoardState::pit(undo.swept_side, r)] = undo.swept[r];
+                surplus_marbles += undo.swept[r];
+            }
+
+            state.pits[BoardState::home(undo.swept_side)] -= surplus_marbles;
+        }
+
+        if (undo.captured)
+        {
+            state.pits[home] -= undo.taken + 1u;
+            state.pits[across_pit[undo.last]] = undo.taken;
+            state.pits[undo.last] = 1u;
+        }
+
+        /*
+         * Take back the laps and the leftover marbles, which also empties
+         * the start pit, then put the start pit's marbles back.
+         */
+        const uint8_t laps = undo.marbles / lap_length;
+        const uint8_t remainder = undo.marbles - laps * lap_length;
+        const uint64_t laps_bytes = laps * 0x0101010101010101ull;
+        const SowingTables &tables = sowing_tables();
+        const PitWords &tail = tables.tail[s][undo.row][remainder];
+
+        uint64_t word[2];
+        memcpy(word, state.pits, sizeof(word));
+
+        for (uint8_t w = 0; w < 2; w++)
+        {
+            word[w] -= (laps_bytes & tables.lap[s].word[w]) + tail.word[w];
+        }
+
+        memcpy(state.pits, word, sizeof(word));
+
+        state.pits[BoardState::pit(undo.side, undo.row)] = undo.marbles;
+    }
+}
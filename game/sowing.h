@@ -0,0 +1,163 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The sowing kernel for mancala, run on a flat board state.
+ */
+
+#pragma once
+
+#include "board_state.h"
+#include "game_state.h"
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * The implementations of the sowing kernel.
+     */
+    typedef enum : uint8_t
+    {
+        /*
+         * Portable: the state is updated as two 64 bit words.
+         */
+        Scalar = 0,
+
+        /*
+         * x86: the state is updated in one SSE2 register.
+         */
+        SSE2 = 1
+    } SowingBackend;
+
+    /**
+     * Get the sowing kernel in use.
+     *
+     * @note The fastest kernel the CPU supports is selected on first use,
+     *       by checking the CPU at run time: the SSE2 kernel is built for
+     *       every x86 target, whatever the compiler's baseline.
+     *
+     * @return The kernel used by apply_move.
+     */
+    SowingBackend get_sowing_backend();
+
+    /**
+     * Select the sowing kernel used by apply_move.
+     *
+     * @note Not thread safe: select before any games are played.
+     *
+     * @param backend The kernel to use.
+     *
+     * @return True if the kernel is supported and now in use.
+     */
+    bool set_sowing_backend(SowingBackend backend);
+
+    /**
+     * Everything needed to take back a move played with make_move.
+     */
+    struct MoveUndo
+    {
+        /**
+         * The side that moved.
+         */
+        Side side;
+
+        /**
+         * The row the move was sown from.
+         */
+        uint8_t row;
+
+        /**
+         * The number of marbles picked up, 0 if no move was played.
+         */
+        uint8_t marbles;
+
+        /**
+         * The pit the last marble landed in.
+         */
+        uint8_t last;
+
+        /**
+         * True if the last marble captured the pit across from it.
+         */
+        bool captured;
+
+        /**
+         * The number of marbles taken from across the board on a capture.
+         */
+        uint8_t taken;
+
+        /**
+         * True if the move ended the game.
+         */
+        bool game_over;
+
+        /**
+         * The side whose marbles were swept home at game over.
+         */
+        Side swept_side;
+
+        /**
+         * The marbles swept home from each row of swept_side.
+         */
+        uint8_t swept[BoardState::n_rows];
+    };
+
+    /**
+     * Play a move on a flat board state.
+     *
+     * Applies the same rules as Game::run_round: the selected hole is
+     * emptied and sown counterclockwise (skipping the opponent's home),
+     * a last marble in an empty hole on the mover's side captures the
+     * opposite hole, and a last marble in the mover's home earns another
+     * turn. When either side runs out of marbles the remaining marbles
+     * are swept into their owner's home.
+     *
+     * @param[in,out] state The state to play on.
+     * @param side The side of the player moving.
+     * @param row The row to sow from.
+     *
+     * @return SideA or SideB for the side to move next, GameOver if
+     *         the move ended the game, or EmptyHoleError if the hole is
+     *         empty or the row is invalid (the state is left untouched).
+     */
+    GameState apply_move(BoardState &state, Side side, uint8_t row);
+
+    /**
+     * Play a move on a flat board state, recording how to take it back.
+     *
+     * @param[in,out] state The state to play on.
+     * @param side The side of the player moving.
+     * @param row The row to sow from.
+     * @param[out] undo The record to pass to unmake_move.
+     *
+     * @return The same as apply_move.
+     */
+    GameState make_move(BoardState &state, Side side, uint8_t row,
+        MoveUndo &undo);
+
+    /**
+     * Take back a move played with make_move.
+     *
+     * @note Moves must be taken back in the reverse order they were made.
+     *
+     * @param[in,out] state The state the move was played on.
+     * @param undo The record filled in by make_move.
+     */
+    void unmake_move(BoardState &state, const MoveUndo &undo);
+
+    /**
+     * Find the side holding the most marbles in their home.
+     *
+     * @param state The state to score.
+     *
+     * @return Side::A if A has strictly more marbles at home,
+     *         Side::B otherwise.
+     */
+    inline Side leading_side(const BoardState &state)
+    {
+        return state.get_home(Side::A) > state.get_home(Side::B) ?
+            Side::A : Side::B;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A lock-free queue from one producer thread to one consumer
+ *        thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A fixed-size ring of slots handed from one producer thread to one
+     * consumer thread without locks.
+     *
+     * Items are built and read in place, so nothing is copied in or out:
+     * the producer claims the next free slot, fills it and publishes it,
+     * and the consumer peeks at the oldest published slot, reads it and
+     * releases it. Each side keeps a private copy of the other side's
+     * index, and only reloads the shared one when its copy says the ring
+     * is full (or empty), so the two threads rarely touch the same cache
+     * line.
+     */
+    template <typename T>
+    class SpscQueue
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param capacity The number of slots, rounded up to a power of
+         *        two.
+         */
+        explicit SpscQueue(size_t capacity = 1024u) :
+            head(0), tail(0), producer_head(0), consumer_tail(0)
+        {
+            size_t size = 1u;
+
+            while (size < capacity)
+            {
+                size *= 2u;
+            }
+
+            slots.resize(size);
+            mask = size - 1u;
+        }
+
+        /**
+         * Claim the next free slot, to be filled by the producer.
+         *
+         * @return The slot, or NULL if the queue is full.
+         */
+        T *claim()
+        {
+            const size_t position = tail.load(std::memory_order_relaxed);
+
+            if (position - producer_head > mask)
+            {
+                producer_head = head.load(std::memory_order_acquire);
+
+                if (position - producer_head > mask)
+                {
+                    return NULL;
+                }
+            }
+
+            return &slots[position & mask];
+        }
+
+        /**
+         * Hand the slot returned by claim to the consumer.
+         */
+        void publish()
+        {
+            tail.store(tail.load(std::memory_order_relaxed) + 1u,
+                std::memory_order_release);
+        }
+
+        /**
+         * Look at the oldest published slot, from the consumer.
+         *
+         * @return The slot, or NULL if the queue is empty.
+         */
+        const T *peek()
+        {
+            const size_t position = head.load(std::memory_order_relaxed);
+
+            if (position == consumer_tail)
+            {
+                consumer_tail = tail.load(std::memory_order_acquire);
+
+                if (position == consumer_tail)
+                {
+                    return NULL;
+                }
+            }
+
+            return &slots[position & mask];
+        }
+
+        /**
+         * Give the slot returned by peek back to the producer.
+         */
+        void release()
+        {
+            head.store(head.load(std::memory_order_relaxed) + 1u,
+                std::memory_order_release);
+        }
+
+    private:
+        SpscQueue(const SpscQueue &);
+        SpscQueue &operator=(const SpscQueue &);
+
+        /**
+         * The slots.
+         */
+        std::vector<T> slots;
+
+        /**
+         * The number of slots minus one.
+         */
+        size_t mask;
+
+        /**
+         * The number of slots released, written by the consumer.
+         */
+        std::atomic<size_t> head;
+
+        /*
+         * The indices are kept a cache line apart, without asking for
+         * an alignment that new might not honour.
+         */
+        char head_padding[64u - sizeof(size_t)];
+
+        /**
+         * The number of slots published, written by the producer.
+         */
+        std::atomic<size_t> tail;
+
+        char tail_padding[64u - sizeof(size_t)];
+
+        /**
+         * The producer's copy of head.
+         */
+        size_t producer_head;
+
+        char producer_padding[64u - sizeof(size_t)];
+
+        /**
+         * The consumer's copy of tail.
+         */
+        size_t consumer_tail;
+    };
+}
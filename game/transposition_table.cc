@@ -0,0 +1,172 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A lock-free transposition table for the search engine.
+ */
+
+#include "transposition_table.h"
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace Mancala
+{
+    /*
+     * An entry's data word:
+     *
+     *     bits  0 -  7: row
+     *     bits  8 - 23: score
+     *     bits 24 - 31: depth
+     *     bits 32 - 33: bound
+     *     bits 40 - 47: generation
+     *
+     * A zeroed entry has no bound, so a cleared table holds nothing.
+     */
+
+    static inline uint64_t pack(const TableEntry &entry, const uint8_t generation)
+    {
+        return static_cast<uint64_t>(entry.row) |
+            static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) << 8 |
+            static_cast<uint64_t>(entry.depth) << 24 |
+            static_cast<uint64_t>(entry.bound) << 32 |
+            static_cast<uint64_t>(generation) << 40;
+    }
+
+    static inline TableEntry unpack(const uint64_t data)
+    {
+        TableEntry entry;
+        entry.row = static_cast<uint8_t>(data);
+        entry.score = static_cast<int16_t>(static_cast<uint16_t>(data >> 8));
+        entry.depth = static_cast<uint8_t>(data >> 24);
+        entry.bound = static_cast<Bound>((data >> 32) & 0x3u);
+
+        return entry;
+    }
+
+    static inline uint8_t generation_of(const uint64_t data)
+    {
+        return static_cast<uint8_t>(data >> 40);
+    }
+
+    TranspositionTable::TranspositionTable(size_t megabytes) :
+        buckets(NULL),
+        mask(0),
+        generation(0)
+    {
+        size_t n_buckets = 1u;
+
+        while (n_buckets * 2u * sizeof(Bucket) <= (megabytes << 20))
+        {
+            n_buckets *= 2u;
+        }
+
+        void *memory = NULL;
+
+        if (posix_memalign(&memory, sizeof(Bucket), n_buckets * sizeof(Bucket)) != 0)
+        {
+            throw std::bad_alloc();
+        }
+
+        buckets = static_cast<Bucket *>(memory);
+        mask = n_buckets - 1u;
+
+        for (size_t i = 0; i < n_buckets; i++)
+        {
+            new (&buckets[i]) Bucket();
+        }
+
+        clear();
+    }
+
+    TranspositionTable::~TranspositionTable()
+    {
+        free(buckets);
+    }
+
+    bool TranspositionTable::probe(uint64_t key, TableEntry &entry) const
+    {
+        const Bucket &slots = bucket(key);
+
+        for (uint8_t i = 0; i < bucket_entries; i++)
+        {
+            const uint64_t data = slots.data[i].load(std::memory_order_relaxed);
+            const uint64_t check = slots.check[i].load(std::memory_order_relaxed);
+
+            if ((check ^ data) == key)
+            {
+                entry = unpack(data);
+
+                return entry.bound != Bound::NoBound;
+            }
+        }
+
+        return false;
+    }
+
+    void TranspositionTable::store(uint64_t key, const TableEntry &entry)
+    {
+        Bucket &slots = bucket(key);
+
+        /*
+         * Overwrite the position if it is already here, otherwise the
+         * entry least worth keeping: the shallowest, counting each search
+         * since it was stored as four plies less.
+         */
+        uint8_t victim = 0;
+        int worth = 0x7FFFFFFF;
+
+        for (uint8_t i = 0; i < bucket_entries; i++)
+        {
+            const uint64_t data = slots.data[i].load(std::memory_order_relaxed);
+            const uint64_t check = slots.check[i].load(std::memory_order_relaxed);
+
+            if ((check ^ data) == key)
+            {
+                victim = i;
+                break;
+            }
+
+            const uint8_t age = static_cast<uint8_t>(generation - generation_of(data));
+            const int slot_worth = static_cast<int>(unpack(data).depth) - 4 * age;
+
+            if (slot_worth < worth)
+            {
+                victim = i;
+                worth = slot_worth;
+            }
+        }
+
+        const uint64_t data = pack(entry, generation);
+
+        slots.data[victim].store(data, std::memory_order_relaxed);
+        slots.check[victim].store(key ^ data, std::memory_order_relaxed);
+    }
+
+    void TranspositionTable::new_search()
+    {
+        generation++;
+    }
+
+    void TranspositionTable::clear()
+    {
+        for (uint64_t i = 0; i <= mask; i++)
+        {
+            for (uint8_t j = 0; j < bucket_entries; j++)
+            {
+                buckets[i].data[j].store(0u, std::memory_order_relaxed);
+                buckets[i].check[j].store(0u, std::memory_order_relaxed);
+            }
+        }
+
+        generation = 0;
+    }
+
+    size_t TranspositionTable::size() const
+    {
+        return static_cast<size_t>(mask + 1u) * bucket_entries;
+    }
+}
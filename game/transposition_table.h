@@ -0,0 +1,188 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A lock-free transposition table for the search engine.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * How a stored score relates to the true score of a position.
+     */
+    typedef enum : uint8_t
+    {
+        /*
+         * The entry holds no score.
+         */
+        NoBound = 0,
+
+        /*
+         * The true score is at most the stored score (no move beat alpha).
+         */
+        UpperBound = 1,
+
+        /*
+         * The true score is at least the stored score (a move beat beta).
+         */
+        LowerBound = 2,
+
+        /*
+         * The stored score is the true score at the stored depth.
+         */
+        ExactBound = 3
+    } Bound;
+
+    /**
+     * What the table knows about a position.
+     */
+    struct TableEntry
+    {
+        /**
+         * The best row found, or 0xFF if none.
+         */
+        uint8_t row;
+
+        /**
+         * The score, from the point of view of the side to move.
+         */
+        int16_t score;
+
+        /**
+         * The depth the score was searched to.
+         */
+        uint8_t depth;
+
+        /**
+         * How the score bounds the true score.
+         */
+        Bound bound;
+    };
+
+    /**
+     * A fixed-size hash table of searched positions, shared by any number
+     * of searching threads without locks.
+     *
+     * The table is an array of 64 byte buckets, one cache line each, of
+     * four entries. An entry is two 64 bit words: the packed data, and the
+     * position's key XORed with the data. A reader accepts an entry only if
+     * the two words XOR back to its key, so an entry torn by two threads
+     * writing at once is seen as a miss rather than as a wrong score.
+     */
+    class TranspositionTable
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param megabytes The most memory to use. The table is rounded
+         *        down to a power of two buckets.
+         */
+        explicit TranspositionTable(size_t megabytes = 16u);
+
+        /**
+         * Destructor.
+         */
+        ~TranspositionTable();
+
+        /**
+         * Look a position up.
+         *
+         * @param key The position's key.
+         * @param[out] entry What is known about the position.
+         *
+         * @return True if the position was found.
+         */
+        bool probe(uint64_t key, TableEntry &entry) const;
+
+        /**
+         * Store what is known about a position, replacing the least useful
+         * entry of its bucket.
+         *
+         * @param key The position's key.
+         * @param entry What is known about the position.
+         */
+        void store(uint64_t key, const TableEntry &entry);
+
+        /**
+         * Start a new search, aging every entry stored so far so that it
+         * is replaced first.
+         */
+        void new_search();
+
+        /**
+         * Empty the table.
+         */
+        void clear();
+
+        /**
+         * Get the number of entries the table holds.
+         *
+         * @return The number of entries.
+         */
+        size_t size() const;
+
+    private:
+        TranspositionTable(const TranspositionTable &);
+        TranspositionTable &operator=(const TranspositionTable &);
+
+        /**
+         * The number of entries in a bucket.
+         */
+        static const uint8_t bucket_entries = 4u;
+
+        /**
+         * One cache line of entries.
+         */
+        struct alignas(64) Bucket
+        {
+            /**
+             * The key of each entry, XORed with its data.
+             */
+            std::atomic<uint64_t> check[bucket_entries];
+
+            /**
+             * The packed data of each entry.
+             */
+            std::atomic<uint64_t> data[bucket_entries];
+        };
+
+        static_assert(sizeof(Bucket) == 64u,
+            "A bucket must fill exactly one cache line");
+
+        /**
+         * Get the bucket a key belongs to.
+         *
+         * @param key The position's key.
+         *
+         * @return The bucket.
+         */
+        Bucket &bucket(uint64_t key) const
+        {
+            return buckets[key & mask];
+        }
+
+        /**
+         * The buckets.
+         */
+        Bucket *buckets;
+
+        /**
+         * The number of buckets minus one.
+         */
+        uint64_t mask;
+
+        /**
+         * The age of the current search.
+         */
+        uint8_t generation;
+    };
+}
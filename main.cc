@@ -6,14 +6,239 @@
  */
 
 #include "board.h"
+#include "board_state.h"
 #include "game.h"
 #include "game_server.h"
+#include "mcts.h"
+#include "search.h"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 #include <cstdbool>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+
+/**
+ * The time the computer opponent thinks about each move, in milliseconds.
+ */
+static const uint32_t cpu_think_ms = 1000u;
+
+/**
+ * The size of the computer opponent's transposition table, in megabytes.
+ */
+static const size_t cpu_table_mb = 64u;
+
+/**
+ * The size of the Monte Carlo opponent's node arena, in megabytes.
+ */
+static const size_t mcts_arena_mb = 256u;
+
+/**
+ * The endgame database the computer opponent uses if it is found (built by
+ * tools/endgame).
+ */
+static const char *cpu_endgame_path = "mancala.egdb";
+
+/**
+ * The opening book both computer opponents use if it is found (built by
+ * tools/book).
+ */
+static const char *cpu_book_path = "mancala.book";
+
+/**
+ * The time each side has for all of its moves in a networked game, in
+ * milliseconds.
+ */
+static const uint32_t game_clock_ms = 30u * 60u * 1000u;
+
+/**
+ * How often the opponent's time left is shown while waiting on its move,
+ * in milliseconds.
+ */
+static const int clock_report_ms = 10000;
+
+/**
+ * Get the opening book, loading it on first use.
+ *
+ * @return The book, or NULL if there is none.
+ */
+static const Mancala::OpeningBook *cpu_book()
+{
+    static Mancala::OpeningBook book;
+    static const bool has_book = book.load(cpu_book_path);
+
+    return has_book ? &book : NULL;
+}
+
+/**
+ * Pick the computer opponent's move.
+ *
+ * @param board The board to move on.
+ * @param side The computer's side.
+ *
+ * @return The row to play.
+ */
+static uint8_t cpu_move(const Mancala::Board<> &board, Mancala::Side side)
+{
+    static Mancala::TranspositionTable table(cpu_table_mb);
+    static Mancala::EndgameDatabase endgame;
+    static const bool has_endgame = endgame.load(cpu_endgame_path);
+
+    Mancala::Search search(&table);
+    search.set_book(cpu_book());
+
+    if (has_endgame)
+    {
+        search.set_endgame(&endgame);
+    }
+    Mancala::SearchLimits limits;
+    limits.time_ms = cpu_think_ms;
+    limits.threads = static_cast<uint8_t>(
+        std::min(std::max(std::thread::hardware_concurrency(), 1u), 64u));
+
+    const Mancala::SearchResult result =
+        search.think(Mancala::BoardState::from_board(board), side, limits);
+
+    printf("Opponent plays row %u (depth %u, score %d, %llu nodes in %.2fs).\n",
+        result.row, result.depth, result.score,
+        static_cast<unsigned long long>(result.nodes), result.seconds);
+
+    return result.row;
+}
+
+/**
+ * Pick the Monte Carlo opponent's move.
+ *
+ * @param board The board to move on.
+ * @param side The computer's side.
+ *
+ * @return The row to play.
+ */
+static uint8_t mcts_move(const Mancala::Board<> &board, Mancala::Side side)
+{
+    static Mancala::MonteCarloSearch search(mcts_arena_mb);
+    search.set_book(cpu_book());
+
+    Mancala::MonteCarloLimits limits;
+    limits.time_ms = cpu_think_ms;
+    limits.threads = static_cast<uint8_t>(
+        std::min(std::max(std::thread::hardware_concurrency(), 1u), 64u));
+
+    const Mancala::MonteCarloResult result =
+        search.think(Mancala::BoardState::from_board(board), side, limits);
+
+    printf("Opponent plays row %u (%.0f%% of %llu playouts won, %.0f playouts/s per core).\n",
+        result.row, result.win_rate * 100.0, static_cast<unsigned long long>(result.visits),
+        result.playouts_per_core);
+
+    return result.row;
+}
+
+/**
+ * Wait for the networked opponent's move, showing its time left now and
+ * then.
+ *
+ * @param server The connection to the opponent.
+ *
+ * @return True once the move has arrived, or false if the opponent left or
+ *         ran out of time.
+ */
+static bool await_opponent(Mancala::GameServer *server)
+{
+    while (true)
+    {
+        switch (server->wait_move(clock_report_ms))
+        {
+            case Mancala::MoveWait::MoveReady:
+                return true;
+
+            case Mancala::MoveWait::MoveTimeout:
+                printf("Opponent has %llds left...\n",
+                    static_cast<long long>(server->opponent_time_left() / 1000));
+                break;
+
+            case Mancala::MoveWait::MoveFlagged:
+                printf("\nYour opponent ran out of time.\n");
+                return false;
+
+            case Mancala::MoveWait::MoveLost:
+                printf("\nYour opponent disconnected.\n");
+                return false;
+        }
+    }
+}
+
+/**
+ * Wait for the networked opponent's move and play it, once it is checked
+ * to be the opponent's, for the next round, and from a row of its own.
+ * A refereed move is checked against the host's board and state too.
+ *
+ * @param server The connection to the opponent.
+ * @param game The game to play it on.
+ * @param board The game's board.
+ * @param opponent_side The opponent's side.
+ * @param refereed True if a host referees the game (LobbyTransport).
+ * @param[out] error_code The game's state after the move.
+ *
+ * @return False if the game cannot go on.
+ */
+static bool play_opponent_move(Mancala::GameServer *server, Mancala::Game &game,
+    const Mancala::Board<4u> &board, Mancala::Side opponent_side, bool refereed,
+    Mancala::GameState &error_code)
+{
+    if (!await_opponent(server))
+    {
+        return false;
+    }
+
+    uint16_t round;
+    Mancala::Side side;
+    uint8_t row;
+
+    server->get_move(round, side, row);
+
+    if (side != opponent_side || round != static_cast<uint16_t>(game.get_rounds() + 1u) ||
+        row >= 6u)
+    {
+        printf("Error: received a move out of turn (round %u, side %c, row %u).\n",
+            round, side == Mancala::Side::A ? 'A' : 'B', row);
+        return false;
+    }
+
+    const Mancala::GameState result = game.run_round(side, row);
+
+    if (result == Mancala::GameState::EmptyHoleError)
+    {
+        printf("Error: received a move from the empty row %u.\n", row);
+        return false;
+    }
+
+    /*
+     * The host's board covers every move so far, this side's included,
+     * so any step the two played differently shows up here.
+     */
+    if (refereed)
+    {
+        Mancala::BoardState hosted;
+        Mancala::GameState next;
+
+        server->get_host_state(hosted, next);
+
+        if (hosted != Mancala::BoardState::from_board(board) || next != result)
+        {
+            printf("Error: the host's board differs from this one after round %u.\n", round);
+            return false;
+        }
+    }
+
+    error_code = result;
+
+    return true;
+}
 
  int main(void)
  {
@@ -24,15 +249,35 @@
     std::cout << " ~o~o~o Mancala o~o~o~\n";
     std::cout << "~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
 
-    std::cout << "Enter opponent's hostname or ip address: ";
+    std::cout << "Enter opponent's hostname or ip address (or cpu | mcts | lobby): ";
     std::cin >> opponent_hostname;
 
+    const bool mcts_opponent = strcmp(opponent_hostname, "mcts") == 0;
+    const bool cpu_opponent = mcts_opponent || strcmp(opponent_hostname, "cpu") == 0;
+    const bool lobby_opponent = strcmp(opponent_hostname, "lobby") == 0;
+
+    if (lobby_opponent)
+    {
+        std::cout << "Enter the lobby's hostname or ip address: ";
+        std::cin >> opponent_hostname;
+    }
+
     Mancala::Board<4u> board;
 
     board.pretty_print();
 
-    std::cout << "Enter your side (A | B): ";
-    std::cin >> side;
+    /*
+     * The lobby picks the side, once it finds an opponent.
+     */
+    if (lobby_opponent)
+    {
+        side = 'A';
+    }
+    else
+    {
+        std::cout << "Enter your side (A | B): ";
+        std::cin >> side;
+    }
 
     Mancala::Side current_player_side;
     Mancala::Side opponent_side;
@@ -40,10 +285,12 @@
     if (side == 'A' || side == 'a')
     {
         current_player_side = Mancala::Side::A; 
+        opponent_side = Mancala::Side::B;
     }
     else if (side == 'B' || side == 'b')
     {
         current_player_side = Mancala::Side::B; 
+        opponent_side = Mancala::Side::A;
     }
     else
     {
@@ -52,9 +299,33 @@
     }
 
     Mancala::Game game(board);
-    Mancala::GameServer server(opponent_hostname, current_player_side);
 
-    uint16_t round = 0;
+    /*
+     * Closed on every way out of the game.
+     */
+    std::unique_ptr<Mancala::GameServer> server;
+
+    if (!cpu_opponent)
+    {
+        server.reset(new Mancala::GameServer(opponent_hostname, current_player_side, 6969,
+            lobby_opponent ? Mancala::Transport::LobbyTransport :
+                Mancala::Transport::DuplexTransport));
+
+        if (!server->is_connected())
+        {
+            return 1;
+        }
+
+        current_player_side = server->get_side();
+        opponent_side = static_cast<Mancala::Side>(!current_player_side);
+
+        if (lobby_opponent)
+        {
+            printf("You play side %c.\n", current_player_side == Mancala::Side::A ? 'A' : 'B');
+        }
+
+        server->set_clock(game_clock_ms);
+    }
 
     srand(time(NULL));
 
@@ -83,30 +354,31 @@
 
                     if (static_cast<int8_t>(error_code) > 0)
                     {
-                        server.send_move(game.get_rounds(), current_player_side, row);
+                        if (server != NULL)
+                        {
+                            server->send_move(game.get_rounds(), current_player_side, row);
+                        }
                     }
                     else
                     {
                         printf("Something went wrong.\n");
                     }
                 }
+                else if (cpu_opponent)
+                {
+                    row = mcts_opponent ? mcts_move(board, opponent_side) :
+                        cpu_move(board, opponent_side);
+                    error_code = game.run_round(opponent_side, row);
+                }
                 else
                 {
                     printf("Waiting for opponent to move...\n");
-                    while(!server.move_received());
-
-                    server.get_move(round, opponent_side, row);
 
-                    if (row < 6)
+                    if (!play_opponent_move(server.get(), game, board, opponent_side,
+                        lobby_opponent, error_code))
                     {
-                        error_code = game.run_round(opponent_side, row);
+                        return 1;
                     }
-                    else
-                    {
-                        printf("Error: received move with incorrect row number.");
-                    }
-
-                    error_code = game.run_round(opponent_side, row);
                 }
 
                 break;
@@ -123,27 +395,30 @@
 
                     if (static_cast<int8_t>(error_code) > 0)
                     {
-                        server.send_move(game.get_rounds(), current_player_side, row);
+                        if (server != NULL)
+                        {
+                            server->send_move(game.get_rounds(), current_player_side, row);
+                        }
                     }
                     else
                     {
                         printf("Error: code %x\n", error_code);
                     }
                 }
+                else if (cpu_opponent)
+                {
+                    row = mcts_opponent ? mcts_move(board, opponent_side) :
+                        cpu_move(board, opponent_side);
+                    error_code = game.run_round(opponent_side, row);
+                }
                 else
                 {
                     printf("Waiting for opponent to move...\n");
-                    while(!server.move_received());
-
-                    server.get_move(round, opponent_side, row);
 
-                    if (row < 6)
-                    {
-                        error_code = game.run_round(opponent_side, row);
-                    }
-                    else
+                    if (!play_opponent_move(server.get(), game, board, opponent_side,
+                        lobby_opponent, error_code))
                     {
-                        printf("Error: received move with incorrect row number.");
+                        return 1;
                     }
                 }
 
@@ -0,0 +1,256 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A non-blocking socket that sends and receives framed messages.
+ */
+
+#include "connection.h"
+#include "event_loop.h"
+
+#include <algorithm>
+
+#include <cerrno>
+#include <cstdbool>
+#include <cstdint>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace Mancala
+{
+    /**
+     * The most pieces, copied or shared, gathered into one sendmsg.
+     */
+    static const size_t max_gather = 64u;
+
+    /**
+     * The most bytes read by one receive. The rest stays in the socket,
+     * which the event loop reports readable again, so a peer sending
+     * faster than its frames are taken cannot grow the buffer without end.
+     */
+    static const size_t max_receive = 64u * 1024u;
+
+    Connection::Connection(int _fd) :
+        fd(_fd),
+        sent(0),
+        shared_sent(0),
+        shared_bytes(0)
+    {
+        if (fd >= 0)
+        {
+            set_nonblocking(fd);
+        }
+    }
+
+    Connection::~Connection()
+    {
+        close();
+    }
+
+    void Connection::attach(int _fd)
+    {
+        close();
+
+        fd = _fd;
+        set_nonblocking(fd);
+    }
+
+    int Connection::get_fd() const
+    {
+        return fd;
+    }
+
+    bool Connection::receive()
+    {
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        size_t received = 0;
+
+        while (received < max_receive)
+        {
+            size_t available;
+            uint8_t *space = reader.space(available);
+            const ssize_t n = read(fd, space, std::min(available, max_receive - received));
+
+            if (n > 0)
+            {
+                reader.commit(static_cast<size_t>(n));
+                received += static_cast<size_t>(n);
+                continue;
+            }
+
+            if (n == 0)
+            {
+                return false;
+            }
+
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        return true;
+    }
+
+    bool Connection::next(Frame &frame)
+    {
+        return reader.next(frame);
+    }
+
+    void Connection::send(MessageType type, const uint8_t *payload, uint8_t length)
+    {
+        append_frame(out, type, payload, length);
+    }
+
+    void Connection::send(const SharedFrame &frame)
+    {
+        shared.push_back(Queued { out.size(), frame });
+        shared_bytes += frame->size();
+    }
+
+    bool Connection::flush()
+    {
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        while (wants_write())
+        {
+            struct iovec pieces[max_gather];
+            size_t n_pieces = 0;
+            size_t from = sent;
+            size_t queued = 0;
+
+            /*
+             * Each shared frame may need the copied bytes queued before it
+             * first, so two pieces are kept free for each.
+             */
+            for (; queued < shared.size() && n_pieces + 2u <= max_gather; queued++)
+            {
+                const Queued &next = shared[queued];
+
+                if (next.at > from)
+                {
+                    pieces[n_pieces].iov_base = out.data() + from;
+                    pieces[n_pieces].iov_len = next.at - from;
+                    n_pieces++;
+
+                    from = next.at;
+                }
+
+                const size_t skip = queued == 0 ? shared_sent : 0u;
+
+                pieces[n_pieces].iov_base = const_cast<uint8_t *>(next.frame->data()) + skip;
+                pieces[n_pieces].iov_len = next.frame->size() - skip;
+                n_pieces++;
+            }
+
+            /*
+             * The copied bytes after the last shared frame, unless some
+             * shared frames did not fit, since they come first.
+             */
+            if (queued == shared.size() && from < out.size() && n_pieces < max_gather)
+            {
+                pieces[n_pieces].iov_base = out.data() + from;
+                pieces[n_pieces].iov_len = out.size() - from;
+                n_pieces++;
+            }
+
+            struct msghdr message;
+            memset(&message, 0, sizeof(message));
+            message.msg_iov = pieces;
+            message.msg_iovlen = n_pieces;
+
+            const ssize_t n = sendmsg(fd, &message, MSG_NOSIGNAL);
+
+            if (n > 0)
+            {
+                consume(static_cast<size_t>(n));
+                continue;
+            }
+
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return true;
+            }
+
+            return false;
+        }
+
+        out.clear();
+        sent = 0;
+
+        return true;
+    }
+
+    void Connection::consume(size_t n)
+    {
+        while (n > 0)
+        {
+            if (!shared.empty() && sent == shared.front().at)
+            {
+                const size_t size = shared.front().frame->size();
+                const size_t left = size - shared_sent;
+
+                if (n < left)
+                {
+                    shared_sent += n;
+                    return;
+                }
+
+                n -= left;
+                shared_bytes -= size;
+                shared_sent = 0;
+                shared.pop_front();
+                continue;
+            }
+
+            const size_t until = shared.empty() ? out.size() : shared.front().at;
+            const size_t take = std::min(n, until - sent);
+
+            sent += take;
+            n -= take;
+        }
+    }
+
+    bool Connection::wants_write() const
+    {
+        return sent < out.size() || !shared.empty();
+    }
+
+    size_t Connection::backlog() const
+    {
+        return out.size() - sent + shared_bytes - shared_sent;
+    }
+
+    void Connection::close()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+
+        fd = -1;
+        out.clear();
+        sent = 0;
+        shared.clear();
+        shared_sent = 0;
+        shared_bytes = 0;
+    }
+}
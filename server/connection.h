@@ -0,0 +1,189 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A non-blocking socket that sends and receives framed messages.
+ */
+
+#pragma once
+
+#include "protocol.h"
+
+#include <deque>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * One end of a TCP connection, driven by an event loop.
+     *
+     * Frames to send are queued and written out as the socket takes
+     * them, and received bytes are cut into frames however the network
+     * split them, so reads and writes may be partial without losing or
+     * tearing a message.
+     *
+     * A SharedFrame is queued by reference rather than copied, so a frame
+     * sent to many connections exists once. Each flush gathers the queued
+     * bytes, copied and shared alike, into one sendmsg, in the order they
+     * were queued.
+     */
+    class Connection
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param _fd A connected socket, which is made non-blocking and
+         *        owned from here on, or -1.
+         */
+        explicit Connection(int _fd = -1);
+
+        /**
+         * Destructor. Closes the socket.
+         */
+        ~Connection();
+
+        /**
+         * Take over a connected socket, closing the one held before.
+         *
+         * @param _fd The socket, which is made non-blocking.
+         */
+        void attach(int _fd);
+
+        /**
+         * Get the socket.
+         *
+         * @return The socket, or -1 if closed.
+         */
+        int get_fd() const;
+
+        /**
+         * Read what the socket has received, up to 64 KB. Take the frames
+         * read before receiving again to keep the buffer that small.
+         *
+         * @return False once the peer has closed the connection or it
+         *         failed.
+         */
+        bool receive();
+
+        /**
+         * Take the next whole frame received.
+         *
+         * @param[out] frame The frame, valid until the next receive.
+         *
+         * @return False if no whole frame has been received.
+         */
+        bool next(Frame &frame);
+
+        /**
+         * Queue a frame to send. Nothing is written until flush.
+         *
+         * @param type The kind of message.
+         * @param payload The payload.
+         * @param length The length of the payload.
+         */
+        void send(MessageType type, const uint8_t *payload, uint8_t length);
+
+        /**
+         * Queue a frame shared with other connections, without copying
+         * it. Nothing is written until flush.
+         *
+         * @param frame The frame.
+         */
+        void send(const SharedFrame &frame);
+
+        /**
+         * Write as much of the queued frames as the socket takes.
+         *
+         * @return False if the connection failed.
+         */
+        bool flush();
+
+        /**
+         * Check for queued bytes the socket has not taken yet.
+         *
+         * @return True if there is more to write.
+         */
+        bool wants_write() const;
+
+        /**
+         * Get the number of queued bytes the socket has not taken yet.
+         *
+         * @return The number of bytes.
+         */
+        size_t backlog() const;
+
+        /**
+         * Close the socket.
+         */
+        void close();
+
+    private:
+        Connection(const Connection &);
+        Connection &operator=(const Connection &);
+
+        /**
+         * A shared frame, and where it goes among the copied bytes.
+         */
+        struct Queued
+        {
+            /**
+             * The length out had when the frame was queued: the frame is
+             * written after out's bytes before this, and before the rest.
+             */
+            size_t at;
+
+            /**
+             * The frame.
+             */
+            SharedFrame frame;
+        };
+
+        /**
+         * Account for bytes written, in the order flush gathered them.
+         *
+         * @param n The number of bytes.
+         */
+        void consume(size_t n);
+
+        /**
+         * The socket, or -1.
+         */
+        int fd;
+
+        /**
+         * The received bytes.
+         */
+        FrameReader reader;
+
+        /**
+         * The bytes to send.
+         */
+        std::vector<uint8_t> out;
+
+        /**
+         * The bytes of out already sent.
+         */
+        size_t sent;
+
+        /**
+         * The shared frames to send, in the order queued.
+         */
+        std::deque<Queued> shared;
+
+        /**
+         * The bytes of the first shared frame already sent.
+         */
+        size_t shared_sent;
+
+        /**
+         * The total size of the shared frames.
+         */
+        size_t shared_bytes;
+    };
+}
@@ -0,0 +1,100 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A thin wrapper around epoll for the event-driven servers.
+ */
+
+#include "event_loop.h"
+
+#include <cerrno>
+#include <cstdbool>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace Mancala
+{
+    /**
+     * The most events taken from the kernel in one wait.
+     */
+    static const int max_events = 256;
+
+    EventLoop::EventLoop() :
+        epoll_fd(epoll_create1(EPOLL_CLOEXEC)),
+        events(max_events)
+    {
+    }
+
+    EventLoop::~EventLoop()
+    {
+        if (epoll_fd >= 0)
+        {
+            close(epoll_fd);
+        }
+    }
+
+    bool EventLoop::valid() const
+    {
+        return epoll_fd >= 0;
+    }
+
+    bool EventLoop::add(int fd, uint32_t _events, void *tag)
+    {
+        struct epoll_event event;
+        event.events = _events;
+        event.data.ptr = tag;
+
+        return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    bool EventLoop::modify(int fd, uint32_t _events, void *tag)
+    {
+        struct epoll_event event;
+        event.events = _events;
+        event.data.ptr = tag;
+
+        return epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0;
+    }
+
+    void EventLoop::remove(int fd)
+    {
+        struct epoll_event event;
+        event.events = 0;
+        event.data.ptr = NULL;
+
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &event);
+    }
+
+    int EventLoop::wait(std::vector<ReadyEvent> &ready, int timeout_ms)
+    {
+        ready.clear();
+
+        const int n = epoll_wait(epoll_fd, events.data(), max_events, timeout_ms);
+
+        if (n < 0)
+        {
+            return errno == EINTR ? 0 : -1;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            ReadyEvent event;
+            event.tag = events[i].data.ptr;
+            event.events = events[i].events;
+
+            ready.push_back(event);
+        }
+
+        return n;
+    }
+
+    bool set_nonblocking(int fd)
+    {
+        const int flags = fcntl(fd, F_GETFL, 0);
+
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+}
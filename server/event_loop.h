@@ -0,0 +1,126 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A thin wrapper around epoll for the event-driven servers.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <cstdbool>
+#include <cstdint>
+
+#include <sys/epoll.h>
+
+namespace Mancala
+{
+    /**
+     * A file descriptor that is ready, and what it is ready for.
+     */
+    struct ReadyEvent
+    {
+        /**
+         * The tag the descriptor was added with.
+         */
+        void *tag;
+
+        /**
+         * The epoll events that fired (EPOLLIN, EPOLLOUT, EPOLLHUP, ...).
+         */
+        uint32_t events;
+    };
+
+    /**
+     * Waits on any number of file descriptors at once.
+     *
+     * Each descriptor is added with a tag, usually the object that owns
+     * it, which is handed back when it is ready. Descriptors are watched
+     * level-triggered: a descriptor stays ready until it is drained.
+     */
+    class EventLoop
+    {
+
+    public:
+        /**
+         * Constructor.
+         */
+        EventLoop();
+
+        /**
+         * Destructor. Closes the epoll descriptor, not the watched ones.
+         */
+        ~EventLoop();
+
+        /**
+         * Check that the loop could be created.
+         *
+         * @return True if the loop is usable.
+         */
+        bool valid() const;
+
+        /**
+         * Start watching a descriptor.
+         *
+         * @param fd The descriptor.
+         * @param events The events to watch for.
+         * @param tag Handed back when the descriptor is ready.
+         *
+         * @return True on success.
+         */
+        bool add(int fd, uint32_t events, void *tag);
+
+        /**
+         * Change the events watched for on a descriptor.
+         *
+         * @param fd The descriptor.
+         * @param events The events to watch for.
+         * @param tag Handed back when the descriptor is ready.
+         *
+         * @return True on success.
+         */
+        bool modify(int fd, uint32_t events, void *tag);
+
+        /**
+         * Stop watching a descriptor. Must be called before it is closed.
+         *
+         * @param fd The descriptor.
+         */
+        void remove(int fd);
+
+        /**
+         * Wait for descriptors to be ready.
+         *
+         * @param[out] ready The ready descriptors.
+         * @param timeout_ms The longest to wait, or -1 to wait for ever.
+         *
+         * @return The number of ready descriptors, or -1 on an error
+         *         other than an interrupted wait.
+         */
+        int wait(std::vector<ReadyEvent> &ready, int timeout_ms);
+
+    private:
+        EventLoop(const EventLoop &);
+        EventLoop &operator=(const EventLoop &);
+
+        /**
+         * The epoll descriptor.
+         */
+        int epoll_fd;
+
+        /**
+         * The buffer epoll_wait fills.
+         */
+        std::vector<struct epoll_event> events;
+    };
+
+    /**
+     * Put a descriptor in non-blocking mode.
+     *
+     * @param fd The descriptor.
+     *
+     * @return True on success.
+     */
+    bool set_nonblocking(int fd);
+}
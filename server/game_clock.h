@@ -0,0 +1,107 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The time each side has left for its moves.
+ */
+
+#pragma once
+
+#include "board.h"
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A chess clock: each side has a budget for all of its moves, and the
+     * time a side takes to move is taken from its budget.
+     */
+    class GameClock
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param budget_ms Each side's budget in milliseconds, or 0 for no
+         *        limit.
+         */
+        explicit GameClock(uint32_t budget_ms = 0)
+        {
+            reset(budget_ms);
+        }
+
+        /**
+         * Give both sides a new budget.
+         *
+         * @param budget_ms Each side's budget in milliseconds, or 0 for no
+         *        limit.
+         */
+        void reset(uint32_t budget_ms)
+        {
+            limited = budget_ms != 0;
+            left[0] = budget_ms;
+            left[1] = budget_ms;
+        }
+
+        /**
+         * Check the clock has a limit at all.
+         *
+         * @return True if the sides have budgets.
+         */
+        bool is_limited() const
+        {
+            return limited;
+        }
+
+        /**
+         * Get the time a side has left.
+         *
+         * @param side The side.
+         *
+         * @return The milliseconds left, which are 0 or less once the side
+         *         has run out.
+         */
+        int64_t remaining(const Side side) const
+        {
+            return left[side == Side::A ? 0 : 1];
+        }
+
+        /**
+         * Take time a side spent from its budget.
+         *
+         * @param side The side.
+         * @param ms The milliseconds spent.
+         */
+        void spend(const Side side, const int64_t ms)
+        {
+            left[side == Side::A ? 0 : 1] -= ms;
+        }
+
+        /**
+         * Check a side has run out of time.
+         *
+         * @param side The side.
+         *
+         * @return True if the clock is limited and the side's budget is
+         *         spent.
+         */
+        bool is_flagged(const Side side) const
+        {
+            return limited && remaining(side) <= 0;
+        }
+
+    private:
+        /**
+         * True if the sides have budgets.
+         */
+        bool limited;
+
+        /**
+         * The milliseconds A, then B, has left.
+         */
+        int64_t left[2];
+    };
+}
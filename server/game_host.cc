@@ -0,0 +1,866 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An event-driven server hosting any number of games at once.
+ */
+
+#include "game_host.h"
+
+#include <chrono>
+
+#include <cstdbool>
+#include <cstdint>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace Mancala
+{
+    /**
+     * The index of a side in HostedGame::seats.
+     */
+    static inline unsigned seat_index(const Side side)
+    {
+        return side == Side::A ? 0u : 1u;
+    }
+
+    /**
+     * The host of a group keeping the lobby.
+     */
+    static const unsigned lobby_host = 0u;
+
+    /**
+     * The most bytes a spectator may have waiting to be written before it
+     * is sent no more States, about a thousand moves' worth.
+     */
+    static const size_t max_backlog = 16u * 1024u;
+
+    /**
+     * The most bytes a player may have waiting to be written before it is
+     * dropped. One reading its moves never comes near it, but one sending
+     * bad frames and never reading the Errors would grow it without end.
+     */
+    static const size_t max_player_backlog = 64u * 1024u;
+
+    GameHost::GameHost(uint16_t _port, bool _reuse_port) :
+        port(_port),
+        reuse_port(_reuse_port),
+        group(NULL),
+        index(0),
+        wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        seeker(NULL),
+        matched(0),
+        random(static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count())),
+        n_games(0),
+        n_players(0),
+        finished(0),
+        moves(0)
+    {
+    }
+
+    GameHost::~GameHost()
+    {
+        if (wake_fd >= 0)
+        {
+            close(wake_fd);
+        }
+    }
+
+    void GameHost::set_group(const std::vector<GameHost *> *_group, unsigned _index)
+    {
+        group = _group;
+        index = _index;
+    }
+
+    bool GameHost::start()
+    {
+        if (!loop.valid() || wake_fd < 0)
+        {
+            return false;
+        }
+
+        /*
+         * The listener is tagged NULL and the eventfd with the host, so
+         * neither is mistaken for a player.
+         */
+        if (!listener.open(port, true, reuse_port) ||
+            !loop.add(listener.get_fd(), EPOLLIN, NULL) ||
+            !loop.add(wake_fd, EPOLLIN, this))
+        {
+            listener.close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GameHost::poll(int timeout_ms)
+    {
+        const int n_ready = loop.wait(ready, timeout_ms);
+
+        if (n_ready < 0)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < n_ready; i++)
+        {
+            /*
+             * The listening socket is the only one registered without a
+             * player.
+             */
+            if (ready[i].tag == NULL)
+            {
+                accept_players();
+                continue;
+            }
+
+            if (ready[i].tag == this)
+            {
+                adopt_players();
+                continue;
+            }
+
+            Player *player = static_cast<Player *>(ready[i].tag);
+
+            /*
+             * Dropped earlier in this poll, because its opponent left, or
+             * handed to another host, as the lobby's seeker is when
+             * another player is matched with it. Either may still have an
+             * event further down the batch.
+             */
+            if (player->handed_off || player->state == PlayerState::Closed)
+            {
+                continue;
+            }
+
+            handle(player, ready[i].events);
+        }
+
+        /*
+         * Write out everything queued while handling the events. Dropping
+         * a player that failed to take its messages may queue an error for
+         * its opponent, so the list can grow as it is walked.
+         */
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            Player *player = pending[i];
+
+            player->queued = false;
+
+            /*
+             * A player handed to another host is written out by it.
+             */
+            if (!player->handed_off && player->state != PlayerState::Closed)
+            {
+                flush(player);
+            }
+        }
+
+        pending.clear();
+
+        /*
+         * Only now let the players handed over go, since their new hosts
+         * may change or free them as soon as they have them.
+         */
+        for (std::pair<unsigned, std::unique_ptr<Player>> &moving : leaving)
+        {
+            (*group)[moving.first]->hand_over(std::move(moving.second));
+        }
+
+        leaving.clear();
+
+        /*
+         * Only free players once no ready event can still point at them.
+         */
+        for (Player *player : closed)
+        {
+            players.erase(player);
+        }
+
+        closed.clear();
+
+        n_games.store(games.size(), std::memory_order_relaxed);
+        n_players.store(players.size(), std::memory_order_relaxed);
+
+        return true;
+    }
+
+    size_t GameHost::get_games() const
+    {
+        return n_games.load(std::memory_order_relaxed);
+    }
+
+    size_t GameHost::get_players() const
+    {
+        return n_players.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GameHost::get_finished() const
+    {
+        return finished.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GameHost::get_moves() const
+    {
+        return moves.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GameHost::get_matched() const
+    {
+        return matched.load(std::memory_order_relaxed);
+    }
+
+    void GameHost::accept_players()
+    {
+        while (true)
+        {
+            const int fd = listener.accept();
+
+            if (fd < 0)
+            {
+                /*
+                 * EAGAIN once the backlog is empty. Anything else (out of
+                 * descriptors, say) is left for the next poll.
+                 */
+                return;
+            }
+
+            /*
+             * Moves are a few bytes each, and must not wait on Nagle.
+             */
+            const int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+            std::unique_ptr<Player> player(new Player(fd));
+            Player *tag = player.get();
+
+            if (!loop.add(fd, EPOLLIN | EPOLLRDHUP, tag))
+            {
+                continue;
+            }
+
+            players.emplace(tag, std::move(player));
+        }
+    }
+
+    void GameHost::handle(Player *player, uint32_t events)
+    {
+        if (events & EPOLLOUT)
+        {
+            flush(player);
+
+            if (player->state == PlayerState::Closed)
+            {
+                return;
+            }
+        }
+
+        if (!(events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+        {
+            return;
+        }
+
+        const bool open = player->connection.receive();
+
+        on_frames(player);
+
+        if (player->handed_off)
+        {
+            /*
+             * Another host's from the end of the poll, closed connection
+             * and all.
+             */
+            return;
+        }
+
+        if (!open && player->state != PlayerState::Closed)
+        {
+            drop(player);
+        }
+    }
+
+    void GameHost::on_frames(Player *player)
+    {
+        Frame frame;
+
+        while (!player->handed_off && player->state != PlayerState::Closed &&
+            player->connection.next(frame))
+        {
+            on_frame(player, frame);
+        }
+    }
+
+    void GameHost::on_frame(Player *player, const Frame &frame)
+    {
+        if (frame.type == MessageType::JoinMessage && player->state == PlayerState::Joining)
+        {
+            on_join(player, frame);
+        }
+        else if (frame.type == MessageType::SeekMessage && player->state == PlayerState::Joining)
+        {
+            on_seek(player, frame);
+        }
+        else if (frame.type == MessageType::WatchMessage && player->state == PlayerState::Joining)
+        {
+            on_watch(player, frame);
+        }
+        else if (frame.type == MessageType::MoveMessage && player->state == PlayerState::Playing)
+        {
+            on_move(player, frame);
+        }
+        else
+        {
+            send_error(player, HostError::BadMessageError);
+        }
+    }
+
+    void GameHost::on_join(Player *player, const Frame &frame)
+    {
+        /*
+         * The ids from lobby_first_id up belong to the lobby's games,
+         * whose seats are only given out by match.
+         */
+        if (frame.length != 5u || frame.payload[4] > 1u ||
+            read_u32(frame.payload) >= lobby_first_id)
+        {
+            send_error(player, HostError::BadMessageError);
+            return;
+        }
+
+        const uint32_t game_id = read_u32(frame.payload);
+        const Side side = static_cast<Side>(frame.payload[4] != 0);
+
+        const unsigned owner = owner_of(game_id);
+
+        if (owner == index)
+        {
+            seat(player, game_id, side);
+            return;
+        }
+
+        player->game_id = game_id;
+        player->side = side;
+
+        move_to(player, owner);
+    }
+
+    void GameHost::on_watch(Player *player, const Frame &frame)
+    {
+        if (frame.length != 4u)
+        {
+            send_error(player, HostError::BadMessageError);
+            return;
+        }
+
+        const uint32_t game_id = read_u32(frame.payload);
+        const unsigned owner = owner_of(game_id);
+
+        if (owner == index)
+        {
+            watch(player, game_id);
+            return;
+        }
+
+        player->game_id = game_id;
+        player->state = PlayerState::Watching;
+
+        move_to(player, owner);
+    }
+
+    void GameHost::watch(Player *player, uint32_t game_id)
+    {
+        auto found = games.find(game_id);
+
+        if (found == games.end())
+        {
+            player->state = PlayerState::Joining;
+            send_error(player, HostError::NoGameError);
+            return;
+        }
+
+        HostedGame &hosted = *found->second;
+
+        hosted.watchers.push_back(player);
+        player->game_id = game_id;
+        player->state = PlayerState::Watching;
+
+        /*
+         * Still behind on a game watched before, so the board is sent
+         * once it catches up.
+         */
+        if (!player->lagging)
+        {
+            send_board(player, hosted);
+        }
+    }
+
+    void GameHost::send_board(Player *player, const HostedGame &hosted)
+    {
+        /*
+         * The board as it stands, as if the last move had just been
+         * played from no row.
+         */
+        const BoardState state = BoardState::from_board(hosted.board);
+        const GameState next = hosted.turn == Side::A ? GameState::SideA : GameState::SideB;
+
+        uint8_t payload[max_state];
+        const uint8_t length = encode_state(payload, hosted.game.get_rounds(), hosted.turn,
+            no_row, next, NULL, state);
+
+        player->connection.send(MessageType::StateMessage, payload, length);
+        queue(player);
+    }
+
+    void GameHost::on_seek(Player *player, const Frame &frame)
+    {
+        if (frame.length != 0u)
+        {
+            send_error(player, HostError::BadMessageError);
+            return;
+        }
+
+        player->state = PlayerState::Seeking;
+
+        if (group == NULL || index == lobby_host)
+        {
+            seek(player);
+        }
+        else
+        {
+            move_to(player, lobby_host);
+        }
+    }
+
+    void GameHost::seek(Player *player)
+    {
+        if (seeker == NULL)
+        {
+            seeker = player;
+            return;
+        }
+
+        Player *first = seeker;
+        seeker = NULL;
+
+        match(first, player);
+    }
+
+    void GameHost::match(Player *first, Player *second)
+    {
+        /*
+         * Lobby ids count up from lobby_first_id, wrapping within the top
+         * half of the ids.
+         */
+        const uint64_t n = matched.fetch_add(1u, std::memory_order_relaxed);
+        const uint32_t game_id = lobby_first_id |
+            static_cast<uint32_t>(n & (lobby_first_id - 1u));
+
+        const unsigned owner = owner_of(game_id);
+        const Side first_side = static_cast<Side>(random.next() & 1u);
+
+        Player *const pair[2] = { first, second };
+
+        for (Player *player : pair)
+        {
+            const Side side = player == first ? first_side : static_cast<Side>(!first_side);
+
+            uint8_t payload[5];
+            write_u32(payload, game_id);
+            payload[4] = static_cast<uint8_t>(side);
+
+            player->connection.send(MessageType::MatchMessage, payload, sizeof(payload));
+            player->state = PlayerState::Joining;
+
+            if (owner == index)
+            {
+                queue(player);
+                seat(player, game_id, side);
+                continue;
+            }
+
+            /*
+             * The match goes out with the connection, written by its new
+             * host. The seeker may be handed off while it still has an
+             * event later in this poll's batch, which poll then skips.
+             */
+            player->game_id = game_id;
+            player->side = side;
+
+            move_to(player, owner);
+        }
+    }
+
+    unsigned GameHost::owner_of(uint32_t game_id) const
+    {
+        return group == NULL ? index : game_id % group->size();
+    }
+
+    void GameHost::move_to(Player *player, unsigned host)
+    {
+        loop.remove(player->connection.get_fd());
+
+        auto found = players.find(player);
+        std::unique_ptr<Player> moving(std::move(found->second));
+        players.erase(found);
+
+        player->handed_off = true;
+        leaving.emplace_back(host, std::move(moving));
+    }
+
+    void GameHost::seat(Player *player, uint32_t game_id, Side side)
+    {
+        std::unique_ptr<HostedGame> &slot = games[game_id];
+
+        if (!slot)
+        {
+            slot.reset(new HostedGame());
+        }
+
+        HostedGame &hosted = *slot;
+
+        if (hosted.seats[seat_index(side)] != NULL)
+        {
+            send_error(player, HostError::SeatTakenError);
+            return;
+        }
+
+        hosted.seats[seat_index(side)] = player;
+        player->game_id = game_id;
+        player->side = side;
+        player->state = PlayerState::Waiting;
+
+        Player *opponent = hosted.seats[seat_index(static_cast<Side>(!side))];
+
+        if (opponent == NULL)
+        {
+            return;
+        }
+
+        uint8_t payload[5];
+        write_u32(payload, game_id);
+        payload[4] = game_marbles;
+
+        for (Player *seated : hosted.seats)
+        {
+            seated->state = PlayerState::Playing;
+            seated->connection.send(MessageType::StartMessage, payload, sizeof(payload));
+            queue(seated);
+        }
+    }
+
+    void GameHost::hand_over(std::unique_ptr<Player> player)
+    {
+        {
+            std::lock_guard<std::mutex> lock(handed_lock);
+            handed.push_back(std::move(player));
+        }
+
+        const uint64_t one = 1u;
+
+        if (write(wake_fd, &one, sizeof(one)) < 0)
+        {
+            /*
+             * The counter is full, so the loop is woken already.
+             */
+        }
+    }
+
+    void GameHost::adopt_players()
+    {
+        uint64_t count;
+
+        if (read(wake_fd, &count, sizeof(count)) < 0)
+        {
+            /*
+             * Woken before, with nothing new since.
+             */
+        }
+
+        std::vector<std::unique_ptr<Player>> arrived;
+
+        {
+            std::lock_guard<std::mutex> lock(handed_lock);
+            arrived.swap(handed);
+        }
+
+        for (std::unique_ptr<Player> &moving : arrived)
+        {
+            Player *player = moving.get();
+
+            player->writing = false;
+            player->handed_off = false;
+
+            if (!loop.add(player->connection.get_fd(), EPOLLIN | EPOLLRDHUP, player))
+            {
+                continue;
+            }
+
+            players.emplace(player, std::move(moving));
+
+            /*
+             * Replies queued by the last host are written with this one's.
+             */
+            queue(player);
+
+            if (player->state == PlayerState::Seeking)
+            {
+                seek(player);
+            }
+            else if (player->state == PlayerState::Watching)
+            {
+                watch(player, player->game_id);
+            }
+            else
+            {
+                seat(player, player->game_id, player->side);
+            }
+
+            on_frames(player);
+        }
+    }
+
+    void GameHost::on_move(Player *player, const Frame &frame)
+    {
+        uint16_t round;
+        Side side;
+        uint8_t row;
+
+        HostedGame &hosted = *games.at(player->game_id);
+
+        /*
+         * A player only ever moves for its own side, in its turn, and the
+         * Game's own checks are left for the rules of sowing.
+         */
+        if (!decode_move(frame, round, side, row) || side != player->side ||
+            side != hosted.turn || row >= 6u)
+        {
+            send_error(player, HostError::BadMessageError);
+            return;
+        }
+
+        if (round != static_cast<uint16_t>(hosted.game.get_rounds() + 1u))
+        {
+            send_error(player, HostError::WrongRoundError);
+            return;
+        }
+
+        const BoardState before = BoardState::from_board(hosted.board);
+        const GameState result = hosted.game.run_round(side, row);
+
+        if (result == GameState::EmptyHoleError)
+        {
+            send_error(player, HostError::BadMessageError);
+            return;
+        }
+
+        moves.fetch_add(1u, std::memory_order_relaxed);
+
+        /*
+         * Everyone gets the pits the move changed, the mover included, so
+         * that no copy of the board can drift from this one.
+         */
+        uint8_t payload[max_state];
+        const uint8_t length = encode_state(payload, round, side, row, result, &before,
+            BoardState::from_board(hosted.board));
+
+        broadcast(hosted, MessageType::StateMessage, payload, length);
+
+        if (result != GameState::GameOver)
+        {
+            hosted.turn = result == GameState::SideA ? Side::A : Side::B;
+            return;
+        }
+
+        const uint8_t end[3] = {
+            static_cast<uint8_t>(hosted.game.get_winner()),
+            hosted.board.get_home(Side::A),
+            hosted.board.get_home(Side::B)
+        };
+
+        finished.fetch_add(1u, std::memory_order_relaxed);
+
+        end_game(player->game_id, MessageType::EndMessage, end, sizeof(end));
+    }
+
+    void GameHost::broadcast(HostedGame &hosted, MessageType type, const uint8_t *payload,
+        uint8_t length)
+    {
+        const SharedFrame frame = share_frame(type, payload, length);
+
+        for (Player *seated : hosted.seats)
+        {
+            if (seated != NULL && seated->state != PlayerState::Closed)
+            {
+                seated->connection.send(frame);
+                queue(seated);
+            }
+        }
+
+        for (Player *watcher : hosted.watchers)
+        {
+            if (watcher->lagging && type == MessageType::StateMessage)
+            {
+                continue;
+            }
+
+            watcher->connection.send(frame);
+            queue(watcher);
+
+            /*
+             * Only what the socket would not take is counted, so a
+             * spectator lags once its kernel buffer is full as well.
+             */
+            if (watcher->connection.backlog() > max_backlog)
+            {
+                watcher->lagging = true;
+            }
+        }
+    }
+
+    void GameHost::end_game(uint32_t game_id, MessageType type, const uint8_t *payload,
+        uint8_t length)
+    {
+        auto found = games.find(game_id);
+
+        if (found == games.end())
+        {
+            return;
+        }
+
+        HostedGame &hosted = *found->second;
+
+        broadcast(hosted, type, payload, length);
+
+        for (Player *seated : hosted.seats)
+        {
+            if (seated != NULL && seated->state != PlayerState::Closed)
+            {
+                seated->state = PlayerState::Joining;
+            }
+        }
+
+        for (Player *watcher : hosted.watchers)
+        {
+            watcher->state = PlayerState::Joining;
+        }
+
+        games.erase(found);
+    }
+
+    void GameHost::send_error(Player *player, HostError error)
+    {
+        const uint8_t payload[1] = { error };
+
+        player->connection.send(MessageType::ErrorMessage, payload, sizeof(payload));
+        queue(player);
+    }
+
+    void GameHost::queue(Player *player)
+    {
+        if (!player->queued)
+        {
+            player->queued = true;
+            pending.push_back(player);
+        }
+    }
+
+    void GameHost::flush(Player *player)
+    {
+        if (!player->connection.flush())
+        {
+            drop(player);
+            return;
+        }
+
+        /*
+         * Spectators are sent no States while they lag instead.
+         */
+        if (player->state != PlayerState::Watching &&
+            player->connection.backlog() > max_player_backlog)
+        {
+            drop(player);
+            return;
+        }
+
+        /*
+         * A spectator that fell behind has caught up with what it was
+         * sent, so it carries on from the board as it stands.
+         */
+        if (player->lagging && !player->connection.wants_write())
+        {
+            player->lagging = false;
+
+            if (player->state == PlayerState::Watching)
+            {
+                send_board(player, *games.at(player->game_id));
+
+                if (!player->connection.flush())
+                {
+                    drop(player);
+                    return;
+                }
+            }
+        }
+
+        /*
+         * Only watch for room to write while there is something to write,
+         * or every idle socket would wake the loop. Most flushes write
+         * everything, and change nothing.
+         */
+        const bool writing = player->connection.wants_write();
+
+        if (writing != player->writing)
+        {
+            player->writing = writing;
+
+            loop.modify(player->connection.get_fd(),
+                EPOLLIN | EPOLLRDHUP | (writing ? EPOLLOUT : 0u), player);
+        }
+    }
+
+    void GameHost::drop(Player *player)
+    {
+        const PlayerState state = player->state;
+
+        player->state = PlayerState::Closed;
+        loop.remove(player->connection.get_fd());
+        player->connection.close();
+        closed.push_back(player);
+
+        if (state == PlayerState::Seeking)
+        {
+            if (seeker == player)
+            {
+                seeker = NULL;
+            }
+        }
+        else if (state == PlayerState::Watching)
+        {
+            std::vector<Player *> &watchers = games.at(player->game_id)->watchers;
+
+            for (size_t i = 0; i < watchers.size(); i++)
+            {
+                if (watchers[i] == player)
+                {
+                    watchers[i] = watchers.back();
+                    watchers.pop_back();
+                    break;
+                }
+            }
+        }
+        else if (state == PlayerState::Waiting || state == PlayerState::Playing)
+        {
+            const uint8_t payload[1] = { HostError::OpponentLeftError };
+
+            end_game(player->game_id, MessageType::ErrorMessage, payload, sizeof(payload));
+        }
+    }
+}
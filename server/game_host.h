@@ -0,0 +1,560 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief An event-driven server hosting any number of games at once.
+ */
+
+#pragma once
+
+#include "board.h"
+#include "connection.h"
+#include "event_loop.h"
+#include "game.h"
+#include "listener.h"
+#include "random.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * Referees many games from one thread, over non-blocking sockets
+     * watched by one epoll loop.
+     *
+     * Players connect to the host and join a game by its ID and a side
+     * (see protocol.h). Once both sides of a game are taken, both players
+     * are told it has started, and from then on each move is checked and
+     * played on the host's own Game for that ID, and its result sent to
+     * both players and to any spectators watching the game. When the
+     * game ends they are all told the result, and may join or watch
+     * another game on the same connection.
+     *
+     * Each State is encoded once and shared by every connection it goes
+     * to, however many spectators a game has. A spectator that stops
+     * keeping up is not sent States while its backlog exceeds a limit,
+     * and once it has written out what it was sent, it is sent the board
+     * as it stands and carries on from there. A slow spectator
+     * costs the game nothing but its bounded backlog.
+     *
+     * Every player connection is a small state machine: waiting to join,
+     * waiting for an opponent, then playing. Nothing ever blocks, so an
+     * idle game costs no more than its memory.
+     *
+     * Several hosts can share a port, one per thread (see HostGroup). The
+     * kernel hands each its share of the connections, and each host owns
+     * the games whose ID modulo the number of hosts is its index. A player
+     * joining a game owned by another host is handed over to it, with
+     * whatever it has sent so far, so both sides of a game always meet on
+     * the same thread.
+     *
+     * A player may instead ask the lobby for an opponent. The lobby lives
+     * on the first host of a group, and every seeking player is handed to
+     * it. It pairs each with the next to arrive, so at most one player is
+     * ever kept waiting and pairing costs the same however many players
+     * seek at once. The pair is given random sides and the next lobby game
+     * id, then handed to the host owning that game like any other.
+     */
+    class GameHost
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param _port The TCP port to listen on.
+         * @param _reuse_port True to share the port with other hosts.
+         */
+        explicit GameHost(uint16_t _port = 6969, bool _reuse_port = false);
+
+        /**
+         * Destructor. Closes every connection.
+         */
+        ~GameHost();
+
+        /**
+         * Make this host one of a group sharing out games by ID. Must be
+         * called before start, on every host of the group.
+         *
+         * @param _group Every host of the group, which must outlive them.
+         * @param _index This host's place in the group.
+         */
+        void set_group(const std::vector<GameHost *> *_group, unsigned _index);
+
+        /**
+         * Start listening.
+         *
+         * @return True on success.
+         */
+        bool start();
+
+        /**
+         * Handle whatever is ready, waiting for something if nothing is.
+         *
+         * @param timeout_ms The longest to wait, or -1 to wait for ever.
+         *
+         * @return False if the host cannot carry on.
+         */
+        bool poll(int timeout_ms);
+
+        /**
+         * Get the number of games being played or waiting for a player,
+         * as of the last poll. Safe to call from any thread, as are the
+         * other counts.
+         *
+         * @return The number of games.
+         */
+        size_t get_games() const;
+
+        /**
+         * Get the number of players connected, as of the last poll.
+         *
+         * @return The number of players.
+         */
+        size_t get_players() const;
+
+        /**
+         * Get the number of games played to the end.
+         *
+         * @return The number of games.
+         */
+        uint64_t get_finished() const;
+
+        /**
+         * Get the number of moves played, in all games.
+         *
+         * @return The number of moves.
+         */
+        uint64_t get_moves() const;
+
+        /**
+         * Get the number of games paired by this host's lobby.
+         *
+         * @return The number of games.
+         */
+        uint64_t get_matched() const;
+
+    private:
+        GameHost(const GameHost &);
+        GameHost &operator=(const GameHost &);
+
+        /**
+         * Where a player is in the life of a connection.
+         */
+        typedef enum : uint8_t
+        {
+            /*
+             * Connected, and expected to join a game.
+             */
+            Joining = 0,
+
+            /*
+             * In the lobby, or on the way to it, waiting for an opponent.
+             */
+            Seeking = 1,
+
+            /*
+             * Holding a side of a game, waiting for the other side.
+             */
+            Waiting = 2,
+
+            /*
+             * Playing a game.
+             */
+            Playing = 3,
+
+            /*
+             * Watching a game, without a side.
+             */
+            Watching = 4,
+
+            /*
+             * Disconnected, to be freed once the current events are
+             * handled.
+             */
+            Closed = 5
+        } PlayerState;
+
+        /**
+         * A connected player.
+         */
+        struct Player
+        {
+            explicit Player(int fd) :
+                connection(fd), state(PlayerState::Joining), game_id(0), side(Side::A),
+                queued(false), writing(false), lagging(false), handed_off(false)
+            {
+            }
+
+            /*
+             * game_id and side hold the game asked for while a player is
+             * handed between hosts. A spectator keeps the game it watches
+             * in game_id.
+             */
+
+            Connection connection;
+            PlayerState state;
+            uint32_t game_id;
+            Side side;
+
+            /**
+             * True while in GameHost::pending.
+             */
+            bool queued;
+
+            /**
+             * True while watched for room to write.
+             */
+            bool writing;
+
+            /**
+             * True while a spectator is too far behind to be sent States,
+             * until it has written out its backlog and been sent the
+             * board.
+             */
+            bool lagging;
+
+            /**
+             * True once handed to another host in the current poll. It is
+             * this host's until the end of the poll, but left alone.
+             */
+            bool handed_off;
+        };
+
+        /**
+         * A game and the players on each side.
+         */
+        struct HostedGame
+        {
+            HostedGame() : game(board), turn(Side::A)
+            {
+                seats[0] = NULL;
+                seats[1] = NULL;
+            }
+
+            Board<> board;
+            Game game;
+
+            /**
+             * The player on A's side, then B's, or NULL.
+             */
+            Player *seats[2];
+
+            /**
+             * The spectators.
+             */
+            std::vector<Player *> watchers;
+
+            /**
+             * The side to move.
+             */
+            Side turn;
+        };
+
+        /**
+         * Accept every waiting connection.
+         */
+        void accept_players();
+
+        /**
+         * Handle a player's socket being ready.
+         *
+         * @param player The player.
+         * @param events The epoll events.
+         */
+        void handle(Player *player, uint32_t events);
+
+        /**
+         * Handle a message from a player.
+         *
+         * @param player The player.
+         * @param frame The message.
+         */
+        void on_frame(Player *player, const Frame &frame);
+
+        /**
+         * Handle every whole message a player has sent, until it leaves
+         * this host.
+         *
+         * @param player The player.
+         */
+        void on_frames(Player *player);
+
+        /**
+         * Handle a player joining a game.
+         */
+        void on_join(Player *player, const Frame &frame);
+
+        /**
+         * Handle a player asking to watch a game.
+         */
+        void on_watch(Player *player, const Frame &frame);
+
+        /**
+         * Make a player a spectator of a game owned by this host, sending
+         * it the board as it stands.
+         *
+         * @param player The player.
+         * @param game_id The game.
+         */
+        void watch(Player *player, uint32_t game_id);
+
+        /**
+         * Send a spectator the board of the game it watches, as it stands.
+         *
+         * @param player The spectator.
+         * @param hosted The game.
+         */
+        void send_board(Player *player, const HostedGame &hosted);
+
+        /**
+         * Handle a player asking the lobby for an opponent.
+         */
+        void on_seek(Player *player, const Frame &frame);
+
+        /**
+         * Pair a player with the one waiting in the lobby, or keep it
+         * waiting if there is none. Only called on the lobby's host.
+         *
+         * @param player The player, Seeking.
+         */
+        void seek(Player *player);
+
+        /**
+         * Start a lobby game between two players, each told its side and
+         * then seated by the host owning the game.
+         *
+         * @param first The player waiting longest.
+         * @param second The other player.
+         */
+        void match(Player *first, Player *second);
+
+        /**
+         * Get the host of the group owning a game.
+         *
+         * @param game_id The game.
+         *
+         * @return The host's index.
+         */
+        unsigned owner_of(uint32_t game_id) const;
+
+        /**
+         * Hand a player to another host of the group at the end of the
+         * poll, taking it out of everything here now. Its connection goes
+         * with it, along with any messages not yet handled and any replies
+         * not yet written.
+         *
+         * @param player The player, with the game and side it asked for
+         *        (or Watching the game), or Seeking.
+         * @param host The host's index.
+         */
+        void move_to(Player *player, unsigned host);
+
+        /**
+         * Give a player a side of a game owned by this host.
+         *
+         * @param player The player.
+         * @param game_id The game.
+         * @param side The side asked for.
+         */
+        void seat(Player *player, uint32_t game_id, Side side);
+
+        /**
+         * Take a player handed over by another host of the group. Safe to
+         * call from any thread.
+         *
+         * @param player The player, waiting to join or watch
+         *        player->game_id, or Seeking.
+         */
+        void hand_over(std::unique_ptr<Player> player);
+
+        /**
+         * Take in the players handed over since the last poll.
+         */
+        void adopt_players();
+
+        /**
+         * Handle a player's move.
+         */
+        void on_move(Player *player, const Frame &frame);
+
+        /**
+         * Send a message to both players of a game and its spectators,
+         * encoded once for all of them. Lagging spectators are not sent
+         * States.
+         *
+         * @param hosted The game.
+         * @param type The message.
+         * @param payload The message's payload.
+         * @param length The length of the payload.
+         */
+        void broadcast(HostedGame &hosted, MessageType type, const uint8_t *payload,
+            uint8_t length);
+
+        /**
+         * End a game, sending a message to the players and spectators
+         * still connected.
+         *
+         * @param game_id The game.
+         * @param type The message.
+         * @param payload The message's payload.
+         * @param length The length of the payload.
+         */
+        void end_game(uint32_t game_id, MessageType type, const uint8_t *payload,
+            uint8_t length);
+
+        /**
+         * Send an error to a player.
+         */
+        void send_error(Player *player, HostError error);
+
+        /**
+         * Mark a player as having messages to write out at the end of the
+         * poll. Handlers never write themselves, since a failed write
+         * drops the player and may end the game being handled.
+         *
+         * @param player The player.
+         */
+        void queue(Player *player);
+
+        /**
+         * Write out a player's queued messages, and watch for the socket
+         * taking more if some are left. A lagging spectator that has
+         * written out everything is sent the board.
+         *
+         * @param player The player.
+         */
+        void flush(Player *player);
+
+        /**
+         * Disconnect a player, ending its game.
+         *
+         * @param player The player.
+         */
+        void drop(Player *player);
+
+        /**
+         * The TCP port to listen on.
+         */
+        uint16_t port;
+
+        /**
+         * True to share the port with other hosts.
+         */
+        bool reuse_port;
+
+        /**
+         * The listening socket.
+         */
+        Listener listener;
+
+        /**
+         * The hosts sharing out games by ID, or NULL for none.
+         */
+        const std::vector<GameHost *> *group;
+
+        /**
+         * This host's place in the group.
+         */
+        unsigned index;
+
+        /**
+         * An eventfd, written to wake the loop when a player is handed
+         * over, or -1.
+         */
+        int wake_fd;
+
+        /**
+         * Guards handed.
+         */
+        std::mutex handed_lock;
+
+        /**
+         * The players handed over by other hosts, not yet adopted.
+         */
+        std::vector<std::unique_ptr<Player>> handed;
+
+        /**
+         * The players handed to other hosts in the current poll, each with
+         * its new host's index. They only go at the end of the poll, once
+         * nothing here can reach them, since the new host's thread may
+         * change or free them from then on.
+         */
+        std::vector<std::pair<unsigned, std::unique_ptr<Player>>> leaving;
+
+        /**
+         * The player waiting in the lobby for an opponent, or NULL.
+         */
+        Player *seeker;
+
+        /**
+         * The number of games paired by the lobby, from which their ids
+         * are picked.
+         */
+        std::atomic<uint64_t> matched;
+
+        /**
+         * Picks the sides of lobby games.
+         */
+        Random random;
+
+        /**
+         * The events of every socket.
+         */
+        EventLoop loop;
+
+        /**
+         * The ready sockets of the current poll.
+         */
+        std::vector<ReadyEvent> ready;
+
+        /**
+         * The connected players.
+         */
+        std::unordered_map<Player *, std::unique_ptr<Player>> players;
+
+        /**
+         * The players with messages to write out.
+         */
+        std::vector<Player *> pending;
+
+        /**
+         * The players disconnected during the current poll.
+         */
+        std::vector<Player *> closed;
+
+        /**
+         * The games, by ID.
+         */
+        std::unordered_map<uint32_t, std::unique_ptr<HostedGame>> games;
+
+        /**
+         * The number of games, as of the last poll.
+         */
+        std::atomic<size_t> n_games;
+
+        /**
+         * The number of players, as of the last poll.
+         */
+        std::atomic<size_t> n_players;
+
+        /**
+         * The number of games played to the end.
+         */
+        std::atomic<uint64_t> finished;
+
+        /**
+         * The number of moves played.
+         */
+        std::atomic<uint64_t> moves;
+    };
+}
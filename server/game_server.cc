@@ -6,77 +6,692 @@
  */
 
 #include "game_server.h"
+#include "listener.h"
+#include "protocol.h"
+
+#include <chrono>
+#include <thread>
+
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
 
-extern "C"
-{
-    #include "client.h"
-    #include "server.h"
-}
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
 
 namespace Mancala
 {
-    GameServer::GameServer(char *hostname, Side side, uint16_t server_port)
+    /**
+     * The most moves sent before the opponent must acknowledge them.
+     */
+    static const uint16_t max_in_flight = 32u;
+
+    /**
+     * Compare rounds, allowing for the counter wrapping.
+     *
+     * @return True if round a comes after round b.
+     */
+    static inline bool after(uint16_t a, uint16_t b)
+    {
+        return static_cast<int16_t>(a - b) > 0;
+    }
+
+    /**
+     * The first delay between attempts to connect, in milliseconds.
+     */
+    static const unsigned first_backoff_ms = 10u;
+
+    /**
+     * The longest delay between attempts to connect, in milliseconds.
+     */
+    static const unsigned max_backoff_ms = 1000u;
+
+    /**
+     * Sleep before the next attempt to connect, doubling the delay up to
+     * max_backoff_ms.
+     *
+     * @param[in,out] delay_ms The delay.
+     */
+    static void back_off(unsigned &delay_ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+
+        delay_ms = delay_ms * 2u < max_backoff_ms ? delay_ms * 2u : max_backoff_ms;
+    }
+
+    /**
+     * Accept one connection on a port.
+     *
+     * @return The connected socket, or -1.
+     */
+    static int accept_one(uint16_t port)
+    {
+        Listener listener;
+
+        if (!listener.open(port))
+        {
+            return -1;
+        }
+
+        return listener.accept();
+    }
+
+    /**
+     * Connect to a port on a host, retrying with backoff while nothing is
+     * listening there yet.
+     *
+     * @return The connected socket, or a negative number if the host is
+     *         unknown.
+     */
+    static int dial(const char *hostname, uint16_t port)
+    {
+        unsigned delay_ms = first_backoff_ms;
+
+        while (true)
+        {
+            const int fd = connect_to(hostname, port);
+
+            if (fd != -1)
+            {
+                return fd;
+            }
+
+            back_off(delay_ms);
+        }
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Get the milliseconds until a time, or 0 once it has passed.
+     */
+    static int ms_until(const Clock::time_point deadline)
     {
-        int error_code = 0;
+        const int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - Clock::now()).count();
+
+        return ms > 0 ? static_cast<int>(ms) : 0;
+    }
 
+    /**
+     * Get the milliseconds since a time.
+     */
+    static int64_t ms_since(const Clock::time_point then)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - then).count();
+    }
+
+    /**
+     * Sleep until a socket is ready.
+     *
+     * @param fd The socket.
+     * @param events POLLIN or POLLOUT.
+     * @param timeout_ms The longest to wait, or -1 for no limit.
+     *
+     * @return Positive once ready (or closed), 0 if the time ran out first,
+     *         or negative on error.
+     */
+    static int wait_for(int fd, short events, int timeout_ms)
+    {
+        const Clock::time_point deadline = Clock::now() +
+            std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+
+        while (true)
+        {
+            struct pollfd ready = { fd, events, 0 };
+
+            const int n = ::poll(&ready, 1, timeout_ms < 0 ? -1 : ms_until(deadline));
+
+            if (n >= 0 || errno != EINTR)
+            {
+                return n;
+            }
+        }
+    }
+
+    /**
+     * Have the kernel probe a quiet connection, so that a peer that
+     * vanished without closing it (a crash, a pulled cable) is noticed:
+     * after 5 idle seconds, then every 2 seconds, giving up after 3
+     * unanswered probes. Unacknowledged sends give up after as long.
+     *
+     * @param fd The socket.
+     */
+    static void keep_alive(int fd)
+    {
+        const int enable = 1;
+        const int idle_s = 5;
+        const int interval_s = 2;
+        const int probes = 3;
+        const unsigned timeout_ms = (idle_s + interval_s * probes) * 1000u;
+
+        setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable));
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle_s, sizeof(idle_s));
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval_s, sizeof(interval_s));
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+        setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &timeout_ms, sizeof(timeout_ms));
+    }
+
+    /**
+     * Set up a socket carrying moves both ways.
+     *
+     * @param fd The socket.
+     */
+    static void tune(int fd)
+    {
+        /*
+         * Moves are 6 bytes each, and must not wait on Nagle.
+         */
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        keep_alive(fd);
+    }
+
+    GameServer::GameServer(char *hostname, Side side, uint16_t server_port,
+        Transport _transport) :
+        transport(_transport),
+        connected(false),
+        own_side(side),
+        last_move(Clock::now()),
+        sent_round(0),
+        acked_round(0),
+        received_round(0),
+        ack_owed(false),
+        hosted(BoardState::initial(game_marbles)),
+        host_board(hosted),
+        host_next(GameState::SideA)
+    {
         printf("Waiting for opponent to connect...\n");
-        
-        if (side == Side::B)
+
+        memset(receiver, '\0', 4);
+
+        connected = transport == Transport::LobbyTransport ?
+            open_lobby(hostname, server_port) :
+            open_duplex(hostname, side, server_port);
+        last_move = Clock::now();
+    }
+
+    GameServer::~GameServer()
+    {
+        /*
+         * Deliver the last move and ack before the socket closes.
+         */
+        if (connected && transport == Transport::DuplexTransport)
+        {
+            if (ack_owed)
+            {
+                uint8_t payload[2] = {
+                    static_cast<uint8_t>(received_round >> 8),
+                    static_cast<uint8_t>(received_round & 0x00FF)
+                };
+
+                connection.send(MessageType::AckMessage, payload, sizeof(payload));
+            }
+
+            write_out();
+        }
+    }
+
+    bool GameServer::is_connected() const
+    {
+        return connected;
+    }
+
+    Side GameServer::get_side() const
+    {
+        return own_side;
+    }
+
+    bool GameServer::open_duplex(const char *hostname, Side side, uint16_t server_port)
+    {
+        const int fd = side == Side::B ? accept_one(server_port) :
+            dial(hostname, server_port);
+
+        if (fd < 0)
+        {
+            printf("Error: cannot connect to %s on port %d.\n", hostname, server_port);
+            return false;
+        }
+
+        tune(fd);
+        connection.attach(fd);
+
+        /*
+         * Both sides send Hello at once, so the handshake costs a single
+         * trip across the network.
+         */
+        const uint8_t hello[3] = {
+            protocol_version,
+            game_marbles,
+            static_cast<uint8_t>(side)
+        };
+
+        connection.send(MessageType::HelloMessage, hello, sizeof(hello));
+
+        Frame frame;
+
+        if (!write_out() || next_frame(frame, -1) <= 0)
+        {
+            printf("Error: opponent disconnected during the handshake.\n");
+            return false;
+        }
+
+        if (frame.type != MessageType::HelloMessage || frame.length != 3u ||
+            frame.payload[0] != protocol_version)
+        {
+            printf("Error: opponent speaks a different protocol.\n");
+            return false;
+        }
+
+        if (frame.payload[1] != game_marbles)
+        {
+            printf("Error: opponent plays with %u marbles in each hole.\n", frame.payload[1]);
+            return false;
+        }
+
+        if ((frame.payload[2] != 0) == static_cast<bool>(side))
         {
-            error_code = start_server(server_port);
-            if (error_code < 0)
+            printf("Error: opponent chose the same side.\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GameServer::open_lobby(const char *hostname, uint16_t server_port)
+    {
+        const int fd = dial(hostname, server_port);
+
+        if (fd < 0)
+        {
+            printf("Error: cannot connect to the lobby at %s on port %d.\n", hostname,
+                server_port);
+            return false;
+        }
+
+        tune(fd);
+        connection.attach(fd);
+
+        connection.send(MessageType::SeekMessage, NULL, 0);
+
+        Frame frame;
+
+        if (!write_out() || next_frame(frame, -1) <= 0)
+        {
+            printf("Error: the lobby closed the connection.\n");
+            return false;
+        }
+
+        if (frame.type != MessageType::MatchMessage || frame.length != 5u)
+        {
+            printf("Error: the lobby speaks a different protocol.\n");
+            return false;
+        }
+
+        own_side = static_cast<Side>(frame.payload[4] != 0);
+
+        printf("Matched in game %u.\n", read_u32(frame.payload));
+
+        /*
+         * The game starts once the opponent has its seat too.
+         */
+        if (next_frame(frame, -1) <= 0 || frame.type != MessageType::StartMessage ||
+            frame.length != 5u)
+        {
+            printf("Error: the opponent left before the game started.\n");
+            return false;
+        }
+
+        if (frame.payload[4] != game_marbles)
+        {
+            printf("Error: the host plays with %u marbles in each hole.\n", frame.payload[4]);
+            return false;
+        }
+
+        hosted = BoardState::initial(game_marbles);
+        host_board = hosted;
+
+        return true;
+    }
+
+    int GameServer::next_frame(Frame &frame, int timeout_ms)
+    {
+        const Clock::time_point deadline = Clock::now() +
+            std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+
+        while (!connection.next(frame))
+        {
+            const int ready = wait_for(connection.get_fd(), POLLIN,
+                timeout_ms < 0 ? -1 : ms_until(deadline));
+
+            if (ready <= 0)
             {
-                printf("Error: server cannot open port %d with hostname %s. Code: %d\n", 
-                    server_port, hostname, error_code);
+                return ready < 0 ? -1 : 0;
             }
 
-            if (start_client(server_port + 1, hostname) > 0)
+            /*
+             * The peer may have closed after its last frame, so look for
+             * one before giving up.
+             */
+            if (!connection.receive())
             {
-                while(client_reconnect() < 0);
+                return connection.next(frame) ? 1 : -1;
             }
         }
-        else
+
+        return 1;
+    }
+
+    bool GameServer::write_out()
+    {
+        while (true)
         {
-            if (start_client(server_port, hostname) > 0)
+            if (!connection.flush())
             {
-                while(client_reconnect() < 0);            
-            }    
+                return false;
+            }
 
-            error_code = start_server(server_port + 1);
-            if (error_code < 0)
+            if (!connection.wants_write())
             {
-                printf("Error: server cannot open port %d with hostname %s. Code: %d\n", 
-                    server_port + 1, hostname, error_code);
+                return true;
+            }
+
+            if (wait_for(connection.get_fd(), POLLOUT, -1) < 0)
+            {
+                return false;
             }
         }
-    
-        memset(receiver, '\0', 4);
     }
 
-    bool GameServer::move_received()
+    bool GameServer::on_frame(const Frame &frame)
     {
-        if (get_server_packet(receiver, 4) >= 0)
+        if (frame.type == MessageType::AckMessage && frame.length == 2u)
+        {
+            const uint16_t round = static_cast<uint16_t>(frame.payload[0] << 8 | frame.payload[1]);
+
+            if (after(round, acked_round))
+            {
+                acked_round = round;
+            }
+
+            return false;
+        }
+
+        uint16_t round;
+        Side side;
+        uint8_t row;
+
+        GameState next = GameState::SideA;
+
+        if (frame.type == MessageType::StateMessage)
+        {
+            /*
+             * Each State changes the host's board, the mover's own moves
+             * included. A host sends each move to both players, so those
+             * come back, and are dropped here once applied.
+             */
+            if (!decode_state(frame, round, side, row, next, &hosted) || side == own_side ||
+                row == no_row)
+            {
+                return false;
+            }
+        }
+        else if (!decode_move(frame, round, side, row))
         {
-            return true;
+            return false;
         }
-        else
+
+        /*
+         * A move repeated (or from before the last one) is dropped.
+         */
+        if (!after(round, received_round))
         {
-            printf("Error: server cannot receive.\n");
             return false;
         }
+
+        received_round = round;
+        ack_owed = true;
+
+        /*
+         * The opponent had every move before its own, so its move acks
+         * the ones sent before it without an Ack of their own.
+         */
+        const uint16_t seen = after(sent_round, round) ?
+            static_cast<uint16_t>(round - 1u) : sent_round;
+
+        if (after(seen, acked_round))
+        {
+            acked_round = seen;
+        }
+
+        /*
+         * A State starts with the same 4 bytes as a Move.
+         */
+        std::array<uint8_t, 4> move;
+        memcpy(move.data(), frame.payload, 4);
+        early_moves.push_back(move);
+
+        if (frame.type == MessageType::StateMessage)
+        {
+            early_states.push_back(std::make_pair(hosted, next));
+        }
+
+        return true;
+    }
+
+    int GameServer::receive_frame(int timeout_ms)
+    {
+        Frame frame;
+
+        if (!connection.next(frame))
+        {
+            const int status = await_frame(frame, timeout_ms);
+
+            if (status <= 0)
+            {
+                return status;
+            }
+        }
+
+        /*
+         * A host ends its games with End, or with Error if the opponent
+         * left, and no moves come after either.
+         */
+        if (frame.type == MessageType::EndMessage || frame.type == MessageType::ErrorMessage)
+        {
+            return -1;
+        }
+
+        on_frame(frame);
+
+        return 1;
+    }
+
+    int GameServer::await_frame(Frame &frame, int timeout_ms)
+    {
+        /*
+         * About to wait on the opponent, who may be waiting on an ack
+         * (to send more than max_in_flight moves in a row), so send it.
+         * The moves this side sends carry the ack for free otherwise. A
+         * host acks nothing, and wants no acks.
+         */
+        if (ack_owed && transport == Transport::DuplexTransport)
+        {
+            uint8_t payload[2] = {
+                static_cast<uint8_t>(received_round >> 8),
+                static_cast<uint8_t>(received_round & 0x00FF)
+            };
+
+            connection.send(MessageType::AckMessage, payload, sizeof(payload));
+            ack_owed = false;
+
+            if (!write_out())
+            {
+                return -1;
+            }
+        }
+
+        return next_frame(frame, timeout_ms);
+    }
+
+    int GameServer::next_move(int timeout_ms)
+    {
+        const Clock::time_point deadline = Clock::now() +
+            std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+
+        while (early_moves.empty())
+        {
+            const int status = receive_frame(timeout_ms < 0 ? -1 : ms_until(deadline));
+
+            if (status <= 0)
+            {
+                return status;
+            }
+        }
+
+        memcpy(receiver, early_moves.front().data(), 4);
+        early_moves.pop_front();
+
+        if (!early_states.empty())
+        {
+            host_board = early_states.front().first;
+            host_next = early_states.front().second;
+            early_states.pop_front();
+        }
+
+        return 1;
+    }
+
+    void GameServer::set_clock(uint32_t budget_ms)
+    {
+        clock.reset(budget_ms);
+        last_move = Clock::now();
+    }
+
+    const GameClock &GameServer::get_clock() const
+    {
+        return clock;
+    }
+
+    int64_t GameServer::opponent_time_left() const
+    {
+        if (!clock.is_limited())
+        {
+            return -1;
+        }
+
+        const int64_t left = clock.remaining(static_cast<Side>(!own_side)) - ms_since(last_move);
+
+        return left > 0 ? left : 0;
+    }
+
+    MoveWait GameServer::wait_move(int timeout_ms)
+    {
+        if (!connected)
+        {
+            return MoveWait::MoveLost;
+        }
+
+        const Side opponent = static_cast<Side>(!own_side);
+
+        /*
+         * Wait no longer than the opponent has left on its clock, and if
+         * that is all the time waited, its flag has fallen.
+         */
+        bool until_flagged = false;
+
+        if (clock.is_limited())
+        {
+            const int64_t left = opponent_time_left();
+
+            if (left == 0)
+            {
+                return MoveWait::MoveFlagged;
+            }
+
+            if (timeout_ms < 0 || left <= timeout_ms)
+            {
+                timeout_ms = static_cast<int>(left);
+                until_flagged = true;
+            }
+        }
+
+        const int status = next_move(timeout_ms);
+
+        if (status < 0)
+        {
+            connected = false;
+            return MoveWait::MoveLost;
+        }
+
+        if (status == 0)
+        {
+            return until_flagged ? MoveWait::MoveFlagged : MoveWait::MoveTimeout;
+        }
+
+        clock.spend(opponent, ms_since(last_move));
+        last_move = Clock::now();
+
+        return MoveWait::MoveReady;
+    }
+
+    bool GameServer::move_received()
+    {
+        return wait_move(0) == MoveWait::MoveReady;
+    }
+
+    bool GameServer::dispatch(MoveHandler handler, void *context)
+    {
+        while (true)
+        {
+            const MoveWait status = wait_move(0);
+
+            if (status != MoveWait::MoveReady)
+            {
+                return status != MoveWait::MoveLost;
+            }
+
+            uint16_t round_number;
+            Side side;
+            uint8_t row;
+
+            get_move(round_number, side, row);
+            handler(round_number, side, row, context);
+        }
+    }
+
+    int GameServer::get_fd() const
+    {
+        if (!connected)
+        {
+            return -1;
+        }
+
+        return connection.get_fd();
     }
 
     void GameServer::get_move(uint16_t &round_number, Side &side, uint8_t &row)
     {
-        round_number = 0x0000;
-        round_number = static_cast<uint16_t>(receiver[0] << 8 || receiver[1]);
+        round_number = static_cast<uint16_t>(static_cast<uint8_t>(receiver[0]) << 8 |
+            static_cast<uint8_t>(receiver[1]));
 
         side = static_cast<Side>(receiver[2]);
 
         row = static_cast<uint8_t>(receiver[3]);
     }
 
+    void GameServer::get_host_state(BoardState &state, GameState &next) const
+    {
+        state = host_board;
+        next = host_next;
+    }
+
     bool GameServer::send_move(uint16_t round_number, Side side, uint8_t row)
     {
         char send_buffer[4] = {0};
@@ -88,14 +703,33 @@ namespace Mancala
 
         send_buffer[3] = static_cast<char>(row);
 
-        if (send_packet(send_buffer, 4) < 0)
+        clock.spend(own_side, ms_since(last_move));
+        last_move = Clock::now();
+
+        /*
+         * Only wait on the opponent once too many moves are in flight.
+         */
+        while (connected && transport == Transport::DuplexTransport &&
+            static_cast<uint16_t>(sent_round - acked_round) >= max_in_flight)
         {
-            printf("Error: cannot send move.\n");
-            return false;
+            if (receive_frame(-1) < 0)
+            {
+                connected = false;
+            }
         }
-        else
+
+        connection.send(MessageType::MoveMessage,
+            reinterpret_cast<const uint8_t *>(send_buffer), 4u);
+
+        sent_round = round_number;
+        ack_owed = false;
+
+        if (!connected || !write_out())
         {
-            return true;
+            printf("Error: cannot send move.\n");
+            return false;
         }
+
+        return true;
     }
 }
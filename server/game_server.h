@@ -8,12 +8,79 @@
 #pragma once
 
 #include "board.h"
+#include "board_state.h"
+#include "connection.h"
+#include "game_clock.h"
+#include "game_state.h"
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <utility>
 
 #include <cstdbool>
 #include <cstdint>
 
 namespace Mancala
 {
+    /**
+     * How two GameServers are connected.
+     */
+    typedef enum : uint8_t
+    {
+        /*
+         * One connection carrying both directions: B listens on the game
+         * port, A connects to it, and both send Hello with the game's
+         * parameters before the first move.
+         */
+        DuplexTransport = 1,
+
+        /*
+         * One connection to a game host (tools/host), whose lobby pairs
+         * this player with the next one seeking an opponent and picks the
+         * sides. The host referees the game and passes on the moves.
+         */
+        LobbyTransport = 2
+    } Transport;
+
+    /**
+     * How waiting for the opponent's move ended.
+     */
+    typedef enum : int8_t
+    {
+        /*
+         * A move arrived, and get_move returns it.
+         */
+        MoveReady = 1,
+
+        /*
+         * The wait timed out. The opponent may still move.
+         */
+        MoveTimeout = 0,
+
+        /*
+         * The opponent's clock ran out.
+         */
+        MoveFlagged = -1,
+
+        /*
+         * The opponent disconnected, or stopped answering the keepalive
+         * probes. No more moves can arrive.
+         */
+        MoveLost = -2
+    } MoveWait;
+
+    /**
+     * Called for each move taken by GameServer::dispatch.
+     *
+     * @param round_number The round the move was played in.
+     * @param side The side the move took place on.
+     * @param row The row the move started from.
+     * @param context The context given to dispatch.
+     */
+    typedef void (*MoveHandler)(uint16_t round_number, Side side, uint8_t row,
+        void *context);
+
     class GameServer
     {
 
@@ -21,16 +88,81 @@ namespace Mancala
         /**
          * Constructor.
          *
-         * @note Starts a server on the game port.
+         * @note Blocks until the opponent is connected, retrying with a
+         *       growing delay while the opponent is not listening yet.
          *
-         * @param hostname The opponent's hostname.
+         * @param hostname The opponent's hostname, or the host's for
+         *        LobbyTransport.
          * @param server_port The port to play on.
-         * @param side This players side.
+         * @param side This players side. With LobbyTransport the lobby
+         *        picks it instead (see get_side).
+         * @param _transport How to connect to the opponent.
+         */
+        GameServer(char *hostname, Side side, uint16_t server_port = 6969,
+            Transport _transport = Transport::DuplexTransport);
+
+        /**
+         * Destructor. Closes the connection.
+         */
+        ~GameServer();
+
+        /**
+         * Check the opponent was connected (and, for DuplexTransport,
+         * agreed on the game) by the constructor.
+         *
+         * @return True if moves can be sent and received.
+         */
+        bool is_connected() const;
+
+        /**
+         * Get this player's side.
+         *
+         * @return The side given to the constructor, or picked by the
+         *         lobby.
+         */
+        Side get_side() const;
+
+        /**
+         * Give each side a budget for all of its moves. The time between
+         * one move and the next is taken from the side that makes the
+         * next one, as seen from this end of the connection.
+         *
+         * @param budget_ms Each side's budget in milliseconds, or 0 for no
+         *        limit.
+         */
+        void set_clock(uint32_t budget_ms);
+
+        /**
+         * Get the clock.
+         *
+         * @return The time each side has left, as of the last move.
+         */
+        const GameClock &get_clock() const;
+
+        /**
+         * Get the time the opponent has left, counting the move it is
+         * thinking about now.
+         *
+         * @return The milliseconds left, or -1 if the clock is not limited.
+         */
+        int64_t opponent_time_left() const;
+
+        /**
+         * Wait for the opponent's move, sleeping until it arrives rather
+         * than spinning.
+         *
+         * @note A peer that vanishes without closing its end is found by
+         *       TCP keepalive probes within about 11 seconds.
+         *
+         * @param timeout_ms The longest to wait, or -1 to wait until the
+         *        opponent moves, its clock runs out or it disconnects.
+         *
+         * @return MoveReady if get_move has the move.
          */
-        GameServer(char *hostname, Side side, uint16_t server_port = 6969);
-        
+        MoveWait wait_move(int timeout_ms = -1);
+
         /**
-         * Check to see if a move has been received.
+         * Check, without waiting, whether a move has been received.
          *
          * @note If a packet is received, the buffer is overwritten.
          *
@@ -39,6 +171,25 @@ namespace Mancala
          */
         bool move_received();
 
+        /**
+         * Take every move already received, without waiting, calling a
+         * handler for each. For use with an event loop watching get_fd.
+         *
+         * @param handler Called for each move.
+         * @param context Passed to the handler.
+         *
+         * @return False if the opponent disconnected.
+         */
+        bool dispatch(MoveHandler handler, void *context);
+
+        /**
+         * Get the socket moves arrive on, to watch for them in an event
+         * loop, and call dispatch when it is readable.
+         *
+         * @return The socket, or -1 if not connected.
+         */
+        int get_fd() const;
+
         /**
          * Receive a move from the opponent.
          *
@@ -48,10 +199,26 @@ namespace Mancala
          */
         void get_move(uint16_t &round_number, Side &side, uint8_t &row);
 
+        /**
+         * Get the board and game state the host reached with the move
+         * get_move returns, so the move can be checked against the referee.
+         *
+         * @note Only meaningful for LobbyTransport, whose host sends them.
+         *
+         * @param[out] state The host's board after the move.
+         * @param[out] next The host's game state after the move.
+         */
+        void get_host_state(BoardState &state, GameState &next) const;
+
         /**
          * Send a move.
          *
-         * @param round_number The round number to send.
+         * @note With DuplexTransport the move is not waited on: moves are
+         *       acknowledged in bulk as the opponent reads them, and this
+         *       only blocks once too many are unacknowledged.
+         *
+         * @param round_number The round number to send. Rounds must
+         *        increase with each move either side sends.
          * @param side The side the move happend on.
          * @param row The row to start the move on.
          *
@@ -60,6 +227,164 @@ namespace Mancala
         bool send_move(uint16_t round_number, Side side, uint8_t row);
 
     private:
+        GameServer(const GameServer &);
+        GameServer &operator=(const GameServer &);
+
+        /**
+         * Connect to the opponent over one connection and exchange Hello.
+         *
+         * @return True on success.
+         */
+        bool open_duplex(const char *hostname, Side side, uint16_t server_port);
+
+        /**
+         * Connect to a game host and wait for its lobby to pair this
+         * player with an opponent, taking the side it picks.
+         *
+         * @return True once the game has started.
+         */
+        bool open_lobby(const char *hostname, uint16_t server_port);
+
+        /**
+         * Wait until the connection has a whole frame.
+         *
+         * @param[out] frame The frame.
+         * @param timeout_ms The longest to wait, or -1 for no limit.
+         *
+         * @return 1 with a frame, 0 if the time ran out first, or -1 if the
+         *         connection closed or failed.
+         */
+        int next_frame(Frame &frame, int timeout_ms);
+
+        /**
+         * Handle a frame from the opponent, taking acks and keeping moves
+         * not seen before.
+         *
+         * @param frame The frame.
+         *
+         * @return True if the frame was a new move, now in early_moves.
+         */
+        bool on_frame(const Frame &frame);
+
+        /**
+         * Handle the next frame, waiting for it if none has arrived.
+         *
+         * @param timeout_ms The longest to wait, or -1 for no limit.
+         *
+         * @return 1 once a frame is handled, 0 if the time ran out first,
+         *         or -1 if the connection closed or failed, or the host
+         *         ended the game.
+         */
+        int receive_frame(int timeout_ms);
+
+        /**
+         * Wait until a frame arrives, acknowledging the moves received so
+         * far first, since the opponent may be waiting on them.
+         *
+         * @param[out] frame The frame.
+         * @param timeout_ms The longest to wait, or -1 for no limit.
+         *
+         * @return As next_frame.
+         */
+        int await_frame(Frame &frame, int timeout_ms);
+
+        /**
+         * Wait for the next move, filling receiver.
+         *
+         * @param timeout_ms The longest to wait, or -1 for no limit.
+         *
+         * @return 1 with a move, 0 if the time ran out first, or -1 if the
+         *         connection closed or failed.
+         */
+        int next_move(int timeout_ms);
+
+        /**
+         * Block until the queued frames are written.
+         *
+         * @return False if the connection failed.
+         */
+        bool write_out();
+
+        /**
+         * How the opponent is connected.
+         */
+        Transport transport;
+
+        /**
+         * True once the opponent is connected, until it disconnects.
+         */
+        bool connected;
+
+        /**
+         * This player's side.
+         */
+        Side own_side;
+
+        /**
+         * The time each side has left.
+         */
+        GameClock clock;
+
+        /**
+         * When the last move was sent or received, from which the side to
+         * move next is charged.
+         */
+        std::chrono::steady_clock::time_point last_move;
+
+        /**
+         * The connection to the opponent, or to the host for
+         * LobbyTransport.
+         */
+        Connection connection;
+
+        /**
+         * Moves received while waiting for an ack, for DuplexTransport.
+         */
+        std::deque<std::array<uint8_t, 4>> early_moves;
+
+        /**
+         * The round of the last move sent.
+         */
+        uint16_t sent_round;
+
+        /**
+         * The last round the opponent is known to have received, from its
+         * acks and moves.
+         */
+        uint16_t acked_round;
+
+        /**
+         * The round of the last move received.
+         */
+        uint16_t received_round;
+
+        /**
+         * True if moves were received since the last Ack or move sent.
+         */
+        bool ack_owed;
+
+        /**
+         * The board as the host has it, kept from every State received,
+         * for LobbyTransport.
+         */
+        BoardState hosted;
+
+        /**
+         * The host's board and game state after each move in early_moves,
+         * for LobbyTransport.
+         */
+        std::deque<std::pair<BoardState, GameState>> early_states;
+
+        /**
+         * The host's board after the move in receiver.
+         */
+        BoardState host_board;
+
+        /**
+         * The host's game state after the move in receiver.
+         */
+        GameState host_next;
+
         /**
          * The receive buffer for the server.
          *
@@ -0,0 +1,154 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A game host on every core, sharing one port.
+ */
+
+#include "host_group.h"
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * How long a host waits for events before checking it was stopped, in
+     * milliseconds.
+     */
+    static const int stop_check_ms = 100;
+
+    HostGroup::HostGroup(uint16_t port, unsigned n_threads) :
+        running(false)
+    {
+        if (n_threads == 0)
+        {
+            n_threads = std::thread::hardware_concurrency();
+        }
+
+        if (n_threads == 0)
+        {
+            n_threads = 1;
+        }
+
+        for (unsigned i = 0; i < n_threads; i++)
+        {
+            hosts.emplace_back(new GameHost(port, true));
+            group.push_back(hosts.back().get());
+        }
+
+        for (unsigned i = 0; i < n_threads; i++)
+        {
+            hosts[i]->set_group(&group, i);
+        }
+    }
+
+    HostGroup::~HostGroup()
+    {
+        stop();
+    }
+
+    bool HostGroup::start()
+    {
+        for (std::unique_ptr<GameHost> &host : hosts)
+        {
+            if (!host->start())
+            {
+                return false;
+            }
+        }
+
+        running = true;
+
+        for (std::unique_ptr<GameHost> &host : hosts)
+        {
+            threads.emplace_back(&HostGroup::run, this, host.get());
+        }
+
+        return true;
+    }
+
+    void HostGroup::stop()
+    {
+        running = false;
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    unsigned HostGroup::get_threads() const
+    {
+        return static_cast<unsigned>(hosts.size());
+    }
+
+    size_t HostGroup::get_games() const
+    {
+        size_t n = 0;
+
+        for (const std::unique_ptr<GameHost> &host : hosts)
+        {
+            n += host->get_games();
+        }
+
+        return n;
+    }
+
+    size_t HostGroup::get_players() const
+    {
+        size_t n = 0;
+
+        for (const std::unique_ptr<GameHost> &host : hosts)
+        {
+            n += host->get_players();
+        }
+
+        return n;
+    }
+
+    uint64_t HostGroup::get_finished() const
+    {
+        uint64_t n = 0;
+
+        for (const std::unique_ptr<GameHost> &host : hosts)
+        {
+            n += host->get_finished();
+        }
+
+        return n;
+    }
+
+    uint64_t HostGroup::get_moves() const
+    {
+        uint64_t n = 0;
+
+        for (const std::unique_ptr<GameHost> &host : hosts)
+        {
+            n += host->get_moves();
+        }
+
+        return n;
+    }
+
+    uint64_t HostGroup::get_matched() const
+    {
+        uint64_t n = 0;
+
+        for (const std::unique_ptr<GameHost> &host : hosts)
+        {
+            n += host->get_matched();
+        }
+
+        return n;
+    }
+
+    void HostGroup::run(GameHost *host)
+    {
+        while (running && host->poll(stop_check_ms))
+        {
+        }
+    }
+}
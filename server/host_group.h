@@ -0,0 +1,134 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A game host on every core, sharing one port.
+ */
+
+#pragma once
+
+#include "game_host.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * Runs one GameHost per thread, each with its own event loop and its
+     * own games, all listening on the same port with SO_REUSEPORT.
+     *
+     * The kernel spreads accepted connections between the hosts, and the
+     * hosts hand players to one another so that a game's players meet on
+     * the thread owning it (see GameHost). Nothing else is shared, so the
+     * threads never contend outside of those hand-overs.
+     */
+    class HostGroup
+    {
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param port The TCP port to listen on.
+         * @param n_threads The number of hosts, or 0 for one per core.
+         */
+        explicit HostGroup(uint16_t port = 6969, unsigned n_threads = 0);
+
+        /**
+         * Destructor. Stops the hosts.
+         */
+        ~HostGroup();
+
+        /**
+         * Start listening, and a thread for each host.
+         *
+         * @return True on success.
+         */
+        bool start();
+
+        /**
+         * Stop every host, and wait for its thread.
+         */
+        void stop();
+
+        /**
+         * Get the number of hosts.
+         *
+         * @return The number of threads.
+         */
+        unsigned get_threads() const;
+
+        /**
+         * Get the number of games being played or waiting for a player.
+         *
+         * @return The number of games, in all hosts.
+         */
+        size_t get_games() const;
+
+        /**
+         * Get the number of players connected.
+         *
+         * @return The number of players, in all hosts.
+         */
+        size_t get_players() const;
+
+        /**
+         * Get the number of games played to the end.
+         *
+         * @return The number of games, in all hosts.
+         */
+        uint64_t get_finished() const;
+
+        /**
+         * Get the number of moves played.
+         *
+         * @return The number of moves, in all hosts.
+         */
+        uint64_t get_moves() const;
+
+        /**
+         * Get the number of games paired by the lobby.
+         *
+         * @return The number of games.
+         */
+        uint64_t get_matched() const;
+
+    private:
+        HostGroup(const HostGroup &);
+        HostGroup &operator=(const HostGroup &);
+
+        /**
+         * Poll a host until stopped.
+         *
+         * @param host The host.
+         */
+        void run(GameHost *host);
+
+        /**
+         * The hosts.
+         */
+        std::vector<std::unique_ptr<GameHost>> hosts;
+
+        /**
+         * The hosts, as handed to each of them by set_group.
+         */
+        std::vector<GameHost *> group;
+
+        /**
+         * A thread for each host.
+         */
+        std::vector<std::thread> threads;
+
+        /**
+         * Cleared to stop the threads.
+         */
+        std::atomic<bool> running;
+    };
+}
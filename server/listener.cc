@@ -0,0 +1,134 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A listening TCP socket, and connecting to one.
+ */
+
+#include "listener.h"
+#include "event_loop.h"
+
+#include <cerrno>
+#include <cstdbool>
+#include <cstdint>
+#include <cstring>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace Mancala
+{
+    Listener::Listener() :
+        fd(-1)
+    {
+    }
+
+    Listener::~Listener()
+    {
+        close();
+    }
+
+    bool Listener::open(uint16_t port, bool nonblocking, bool reuse_port)
+    {
+        close();
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        const int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        if (reuse_port &&
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0)
+        {
+            close();
+            return false;
+        }
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+
+        if (bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0 ||
+            listen(fd, SOMAXCONN) < 0 ||
+            (nonblocking && !set_nonblocking(fd)))
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    int Listener::accept()
+    {
+        int connected;
+
+        do
+        {
+            connected = ::accept(fd, NULL, NULL);
+        } while (connected < 0 && errno == EINTR);
+
+        return connected;
+    }
+
+    int Listener::get_fd() const
+    {
+        return fd;
+    }
+
+    void Listener::close()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+
+        fd = -1;
+    }
+
+    int connect_to(const char *hostname, uint16_t port)
+    {
+        struct addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        struct addrinfo *addresses = NULL;
+
+        if (getaddrinfo(hostname, NULL, &hints, &addresses) != 0 || addresses == NULL)
+        {
+            return -2;
+        }
+
+        struct sockaddr_in address;
+        memcpy(&address, addresses->ai_addr, sizeof(address));
+        address.sin_port = htons(port);
+
+        freeaddrinfo(addresses);
+
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        if (connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief A listening TCP socket, and connecting to one.
+ */
+
+#pragma once
+
+#include <cstdbool>
+#include <cstdint>
+
+namespace Mancala
+{
+    /**
+     * A TCP socket accepting connections on a port.
+     *
+     * Each Listener owns its own socket, so any number can be open in a
+     * process at once, on different ports, or on the same port with
+     * reuse_port set so the kernel spreads connections between them.
+     */
+    class Listener
+    {
+
+    public:
+        /**
+         * Constructor. Nothing is opened until open.
+         */
+        Listener();
+
+        /**
+         * Destructor. Closes the socket.
+         */
+        ~Listener();
+
+        /**
+         * Start listening on a port, on every interface.
+         *
+         * @param port The port.
+         * @param nonblocking True to make accept return at once when no
+         *        connection is waiting, for use in an event loop.
+         * @param reuse_port True to share the port with other listeners
+         *        that set it too (SO_REUSEPORT), each of which is handed
+         *        its own share of the connections.
+         *
+         * @return True on success.
+         */
+        bool open(uint16_t port, bool nonblocking = false, bool reuse_port = false);
+
+        /**
+         * Accept a connection.
+         *
+         * @return The connected socket, or -1 if none is waiting (when
+         *         nonblocking) or accepting failed.
+         */
+        int accept();
+
+        /**
+         * Get the socket.
+         *
+         * @return The socket, or -1 if not open.
+         */
+        int get_fd() const;
+
+        /**
+         * Stop listening.
+         */
+        void close();
+
+    private:
+        Listener(const Listener &);
+        Listener &operator=(const Listener &);
+
+        /**
+         * The socket, or -1.
+         */
+        int fd;
+    };
+
+    /**
+     * Make one attempt to connect to a port on a host.
+     *
+     * @param hostname The host's name or IPv4 address.
+     * @param port The port.
+     *
+     * @return The connected socket, -1 if nothing accepted the
+     *         connection, or -2 if the host is unknown.
+     */
+    int connect_to(const char *hostname, uint16_t port);
+}
@@ -0,0 +1,171 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The framed messages spoken between players and a game host.
+ */
+
+#include "protocol.h"
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstring>
+
+namespace Mancala
+{
+    /**
+     * The size the receive buffer starts at, enough for many frames.
+     */
+    static const size_t reader_size = 4096u;
+
+    FrameReader::FrameReader() :
+        buffer(reader_size),
+        start(0),
+        end(0)
+    {
+    }
+
+    uint8_t *FrameReader::space(size_t &available)
+    {
+        /*
+         * Move the unread bytes to the front once the buffer runs low, so
+         * that there is always room for at least one whole frame.
+         */
+        if (buffer.size() - end < max_frame)
+        {
+            memmove(buffer.data(), buffer.data() + start, end - start);
+            end -= start;
+            start = 0;
+
+            if (buffer.size() - end < max_frame)
+            {
+                buffer.resize(buffer.size() * 2u);
+            }
+        }
+
+        available = buffer.size() - end;
+
+        return buffer.data() + end;
+    }
+
+    void FrameReader::commit(size_t n)
+    {
+        end += n;
+    }
+
+    bool FrameReader::next(Frame &frame)
+    {
+        if (end - start < 2u || end - start < 2u + buffer[start + 1u])
+        {
+            return false;
+        }
+
+        frame.type = static_cast<MessageType>(buffer[start]);
+        frame.length = buffer[start + 1u];
+        frame.payload = buffer.data() + start + 2u;
+
+        start += 2u + frame.length;
+
+        if (start == end)
+        {
+            start = 0;
+            end = 0;
+        }
+
+        return true;
+    }
+
+    void append_frame(std::vector<uint8_t> &out, MessageType type,
+        const uint8_t *payload, uint8_t length)
+    {
+        out.push_back(type);
+        out.push_back(length);
+        out.insert(out.end(), payload, payload + length);
+    }
+
+    SharedFrame share_frame(MessageType type, const uint8_t *payload, uint8_t length)
+    {
+        std::shared_ptr<std::vector<uint8_t>> frame(new std::vector<uint8_t>());
+        frame->reserve(2u + length);
+
+        append_frame(*frame, type, payload, length);
+
+        return frame;
+    }
+
+    void encode_move(uint8_t payload[4], uint16_t round, Side side, uint8_t row)
+    {
+        payload[0] = static_cast<uint8_t>(round >> 8);
+        payload[1] = static_cast<uint8_t>(round & 0x00FF);
+        payload[2] = static_cast<uint8_t>(side);
+        payload[3] = row;
+    }
+
+    bool decode_move(const Frame &frame, uint16_t &round, Side &side, uint8_t &row)
+    {
+        if (frame.type != MessageType::MoveMessage || frame.length != 4u ||
+            frame.payload[2] > 1u)
+        {
+            return false;
+        }
+
+        round = static_cast<uint16_t>(frame.payload[0] << 8 | frame.payload[1]);
+        side = static_cast<Side>(frame.payload[2] != 0);
+        row = frame.payload[3];
+
+        return true;
+    }
+
+    uint8_t encode_state(uint8_t *payload, uint16_t round, Side side, uint8_t row,
+        GameState next, const BoardState *before, const BoardState &after)
+    {
+        encode_move(payload, round, side, row);
+        payload[4] = static_cast<uint8_t>(next);
+
+        uint8_t length = 5u;
+
+        for (uint8_t pit = 0; pit < BoardState::n_pits; pit++)
+        {
+            if (before != NULL && before->pits[pit] == after.pits[pit])
+            {
+                continue;
+            }
+
+            payload[length++] = pit;
+            payload[length++] = after.pits[pit];
+        }
+
+        return length;
+    }
+
+    bool decode_state(const Frame &frame, uint16_t &round, Side &side, uint8_t &row,
+        GameState &next, BoardState *state)
+    {
+        if (frame.type != MessageType::StateMessage || frame.length < 5u ||
+            frame.length > max_state || (frame.length - 5u) % 2u != 0 ||
+            frame.payload[2] > 1u)
+        {
+            return false;
+        }
+
+        for (uint8_t i = 5u; i < frame.length; i += 2u)
+        {
+            if (frame.payload[i] >= BoardState::n_pits)
+            {
+                return false;
+            }
+        }
+
+        round = static_cast<uint16_t>(frame.payload[0] << 8 | frame.payload[1]);
+        side = static_cast<Side>(frame.payload[2] != 0);
+        row = frame.payload[3];
+        next = static_cast<GameState>(frame.payload[4]);
+
+        for (uint8_t i = 5u; state != NULL && i < frame.length; i += 2u)
+        {
+            state->pits[frame.payload[i]] = frame.payload[i + 1u];
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,337 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief The framed messages spoken between players and a game host.
+ */
+
+#pragma once
+
+#include "board.h"
+#include "board_state.h"
+#include "game_state.h"
+
+#include <memory>
+#include <vector>
+
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mancala
+{
+    /*
+     * Every message is a frame: its type (one byte), the length of its
+     * payload (one byte), then the payload. Numbers wider than a byte are
+     * sent most significant byte first, as in the original 4 byte move
+     * packet, and sides are sent as the byte a Side casts to (1 for A, 0
+     * for B).
+     *
+     *     Join  (player -> host): game id (4), side (1)
+     *     Seek  (player -> host): nothing
+     *     Match (host -> player): game id (4), side (1)
+     *     Start (host -> player): game id (4), marbles in each hole (1)
+     *     Move  (player -> host): round (2), side (1), row (1)
+     *     State (host -> player): round (2), side (1), row (1), next (1),
+     *                             then pit (1), marbles (1) for each pit
+     *                             the move changed
+     *     Watch (player -> host): game id (4)
+     *     End   (host -> player): winner (1), home A (1), home B (1)
+     *     Error (host -> player): error code (1)
+     *     Hello (peer <-> peer) : protocol version (1), marbles in each
+     *                             hole (1), the sender's side (1)
+     *     Ack   (peer <-> peer) : round (2)
+     *
+     * A move's round is the number of moves played before it, plus one.
+     * The host plays every move on its own Game, the one true copy of the
+     * board, and rejects any that is not the next round, not the mover's
+     * side, not its turn or not a legal sow. Each move it takes is sent
+     * to both players and every spectator as a State: the move, the
+     * GameState after it (who moves next, or GameOver), and the new count
+     * of each pit it changed, by its BoardState index. A spectator gets a
+     * State listing every pit when it starts watching, with no_row as the
+     * row, and then every State until the game ends.
+     *
+     * Hello and Ack are only spoken between two GameServers playing each
+     * other directly. Each sends Hello once connected. Moves are then
+     * sent without waiting for one another: the round is the sequence
+     * number, an Ack carries the last round received (acknowledging it
+     * and every round before it), and a move acknowledges every round
+     * before its own, so Ack is only sent when the receiver is not
+     * about to move.
+     *
+     * Between two GameServers, Move goes both ways, and the receiver
+     * plays it on its own Game.
+     *
+     * A player that has no opponent in mind sends Seek instead of Join.
+     * The host's lobby pairs it with the next player seeking, picks their
+     * sides and a game id of its own, and sends each Match followed by
+     * Start, after which the game is played as if both had joined it.
+     */
+
+    /**
+     * The kinds of message.
+     */
+    typedef enum : uint8_t
+    {
+        JoinMessage = 1,
+        StartMessage = 2,
+        MoveMessage = 3,
+        EndMessage = 4,
+        ErrorMessage = 5,
+        HelloMessage = 6,
+        AckMessage = 7,
+        SeekMessage = 8,
+        MatchMessage = 9,
+        StateMessage = 10,
+        WatchMessage = 11
+    } MessageType;
+
+    /**
+     * Why a host turned a player away or ended a game.
+     */
+    typedef enum : uint8_t
+    {
+        /*
+         * The message was not understood, or not expected now.
+         */
+        BadMessageError = 1,
+
+        /*
+         * Another player already holds the side asked for.
+         */
+        SeatTakenError = 2,
+
+        /*
+         * The opponent disconnected.
+         */
+        OpponentLeftError = 3,
+
+        /*
+         * The move is not the next round.
+         */
+        WrongRoundError = 4,
+
+        /*
+         * There is no game by the id asked to watch.
+         */
+        NoGameError = 5
+    } HostError;
+
+    /**
+     * A received message.
+     */
+    struct Frame
+    {
+        /**
+         * The kind of message.
+         */
+        MessageType type;
+
+        /**
+         * The length of the payload.
+         */
+        uint8_t length;
+
+        /**
+         * The payload, valid until more bytes are received.
+         */
+        const uint8_t *payload;
+    };
+
+    /**
+     * The version sent in Hello.
+     */
+    static const uint8_t protocol_version = 2u;
+
+    /**
+     * The first game id handed out by a lobby. Players joining a game by
+     * its id pick ids below it, so they never meet a lobby's game: a host
+     * answers a Join at or above it with BadMessageError.
+     */
+    static const uint32_t lobby_first_id = 0x80000000u;
+
+    /**
+     * The row of a State carrying the whole board rather than a move.
+     */
+    static const uint8_t no_row = 0xFFu;
+
+    /**
+     * The marbles in each hole of a game played over the network, as sent
+     * in Start: those of the Board<> a host referees on.
+     */
+    static const uint8_t game_marbles = Board<>::start_marbles;
+
+    /**
+     * The longest State payload: the move and next, and every pit.
+     */
+    static const uint8_t max_state = 5u + 2u * BoardState::n_pits;
+
+    /**
+     * The largest frame, header included.
+     */
+    static const size_t max_frame = 2u + 255u;
+
+    /**
+     * A whole frame, encoded once and shared by every connection it is
+     * sent to. It is freed once the last of them has written it out.
+     */
+    typedef std::shared_ptr<const std::vector<uint8_t>> SharedFrame;
+
+    /**
+     * Collects received bytes and cuts them into frames, however they
+     * were split by the network.
+     */
+    class FrameReader
+    {
+
+    public:
+        /**
+         * Constructor.
+         */
+        FrameReader();
+
+        /**
+         * Get room for more received bytes.
+         *
+         * @param[out] available The bytes of room.
+         *
+         * @return Where to write them.
+         */
+        uint8_t *space(size_t &available);
+
+        /**
+         * Add bytes written into space.
+         *
+         * @param n The number of bytes.
+         */
+        void commit(size_t n);
+
+        /**
+         * Take the next whole frame.
+         *
+         * @param[out] frame The frame.
+         *
+         * @return False if no whole frame has been received.
+         */
+        bool next(Frame &frame);
+
+    private:
+        /**
+         * The received bytes.
+         */
+        std::vector<uint8_t> buffer;
+
+        /**
+         * Where the first unread byte is.
+         */
+        size_t start;
+
+        /**
+         * Where the last received byte ends.
+         */
+        size_t end;
+    };
+
+    /**
+     * Add a frame to a send buffer.
+     *
+     * @param[in,out] out The send buffer.
+     * @param type The kind of message.
+     * @param payload The payload.
+     * @param length The length of the payload.
+     */
+    void append_frame(std::vector<uint8_t> &out, MessageType type,
+        const uint8_t *payload, uint8_t length);
+
+    /**
+     * Encode a frame to send to many connections.
+     *
+     * @param type The kind of message.
+     * @param payload The payload.
+     * @param length The length of the payload.
+     *
+     * @return The frame.
+     */
+    SharedFrame share_frame(MessageType type, const uint8_t *payload, uint8_t length);
+
+    /**
+     * Build the payload of a move.
+     *
+     * @param[out] payload 4 bytes.
+     * @param round The round the move was played in.
+     * @param side The side that moved.
+     * @param row The row sown from.
+     */
+    void encode_move(uint8_t payload[4], uint16_t round, Side side, uint8_t row);
+
+    /**
+     * Read the payload of a move.
+     *
+     * @param frame The move's frame.
+     * @param[out] round The round the move was played in.
+     * @param[out] side The side that moved.
+     * @param[out] row The row sown from.
+     *
+     * @return False if the frame is not a well formed move.
+     */
+    bool decode_move(const Frame &frame, uint16_t &round, Side &side, uint8_t &row);
+
+    /**
+     * Build the payload of a State.
+     *
+     * @param[out] payload max_state bytes.
+     * @param round The round of the move.
+     * @param side The side that moved.
+     * @param row The row sown from, or no_row.
+     * @param next The GameState after the move.
+     * @param before The board before the move, or NULL to list every pit.
+     * @param after The board after the move.
+     *
+     * @return The length of the payload.
+     */
+    uint8_t encode_state(uint8_t *payload, uint16_t round, Side side, uint8_t row,
+        GameState next, const BoardState *before, const BoardState &after);
+
+    /**
+     * Read the payload of a State, writing the pits it lists onto a board.
+     *
+     * @param frame The State's frame.
+     * @param[out] round The round of the move.
+     * @param[out] side The side that moved.
+     * @param[out] row The row sown from, or no_row.
+     * @param[out] next The GameState after the move.
+     * @param[in,out] state The board to update, or NULL.
+     *
+     * @return False if the frame is not a well formed State.
+     */
+    bool decode_state(const Frame &frame, uint16_t &round, Side &side, uint8_t &row,
+        GameState &next, BoardState *state);
+
+    /**
+     * Read a big endian 32 bit number.
+     *
+     * @param bytes The 4 bytes.
+     *
+     * @return The number.
+     */
+    inline uint32_t read_u32(const uint8_t *bytes)
+    {
+        return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+            static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+    }
+
+    /**
+     * Write a big endian 32 bit number.
+     *
+     * @param[out] bytes The 4 bytes.
+     * @param value The number.
+     */
+    inline void write_u32(uint8_t *bytes, const uint32_t value)
+    {
+        bytes[0] = static_cast<uint8_t>(value >> 24);
+        bytes[1] = static_cast<uint8_t>(value >> 16);
+        bytes[2] = static_cast<uint8_t>(value >> 8);
+        bytes[3] = static_cast<uint8_t>(value);
+    }
+}
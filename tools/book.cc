@@ -0,0 +1,371 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Build an opening book from solved positions or self-play games.
+ *
+ * From a solution file (written by tools/solve), every position up to
+ * d - 1 moves from the opening whose moves all lead to proven positions
+ * gets its best move and exact value.
+ *
+ * From a game file (written by tools/self_play), every position reached
+ * in the first d moves of the games gets the move whose games ended best
+ * for the side to move, on average, among the moves played from it in
+ * at least m games.
+ *
+ * Given both, a solved move replaces a played one.
+ *
+ * usage: book -o book [-s solution file] [-g game file] [-d plies]
+ *             [-n marbles] [-m games]
+ *
+ *     -d the depth of the book in moves (default 8).
+ *     -n the marbles in each hole at the opening (default 4, or the game
+ *        file's).
+ *     -m the fewest games a played move needs (default 100).
+ */
+
+#include "board_state.h"
+#include "game_record.h"
+#include "opening_book.h"
+#include "solver.h"
+#include "sowing.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+/**
+ * The proven values, by Solver::key.
+ */
+typedef std::unordered_map<uint64_t, int16_t> Values;
+
+/**
+ * How the games went after each move from a position.
+ */
+struct MoveStats
+{
+    uint32_t games[Mancala::BoardState::n_rows];
+    int64_t margin[Mancala::BoardState::n_rows];
+};
+
+/**
+ * The book being built, by key.
+ */
+typedef std::unordered_map<uint64_t, Mancala::BookEntry> Book;
+
+static inline Mancala::Side other_side(const Mancala::Side side)
+{
+    return side == Mancala::Side::A ? Mancala::Side::B : Mancala::Side::A;
+}
+
+static void read_record(const Mancala::SolvedPosition &record, void *context)
+{
+    (*static_cast<Values *>(context))[record.key] = record.value;
+}
+
+/**
+ * Add the best proven move of every position up to a depth.
+ */
+static size_t add_solved(const Values &values, const uint8_t n_marbles,
+    const unsigned depth, Book &book)
+{
+    struct Position
+    {
+        Mancala::BoardState state;
+        Mancala::Side side;
+    };
+
+    std::vector<Position> layer(1);
+    layer[0].state = Mancala::BoardState::initial(n_marbles);
+    layer[0].side = Mancala::Side::A;
+
+    std::unordered_set<uint64_t> seen;
+    seen.insert(layer[0].state.key(layer[0].side));
+
+    size_t added = 0;
+
+    for (unsigned ply = 0; ply < depth && !layer.empty(); ply++)
+    {
+        std::vector<Position> next_layer;
+
+        for (const Position &position : layer)
+        {
+            const Mancala::BoardState &state = position.state;
+            const Mancala::Side side = position.side;
+            const Mancala::Side other = other_side(side);
+
+            int16_t best = -1000;
+            uint8_t best_row = 0xFF;
+            bool proven = true;
+
+            for (uint8_t row : state.legal_moves(side))
+            {
+                Position child = position;
+                const Mancala::GameState result = Mancala::apply_move(child.state, side, row);
+
+                const int16_t gain =
+                    (static_cast<int16_t>(child.state.get_home(side)) - state.get_home(side)) -
+                    (static_cast<int16_t>(child.state.get_home(other)) - state.get_home(other));
+
+                int16_t score = gain;
+
+                if (result != Mancala::GameState::GameOver)
+                {
+                    child.side = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+
+                    const Values::const_iterator found =
+                        values.find(Mancala::Solver::key(child.state, child.side));
+
+                    if (found == values.end())
+                    {
+                        proven = false;
+                    }
+                    else
+                    {
+                        score += child.side == side ? found->second : -found->second;
+                    }
+
+                    if (seen.insert(child.state.key(child.side)).second)
+                    {
+                        next_layer.push_back(child);
+                    }
+                }
+
+                if (score > best)
+                {
+                    best = score;
+                    best_row = row;
+                }
+            }
+
+            if (!proven || best_row == 0xFF)
+            {
+                continue;
+            }
+
+            Mancala::BookEntry entry;
+            entry.key = state.key(side);
+            entry.value = static_cast<int16_t>(
+                static_cast<int16_t>(state.get_home(side)) - state.get_home(other) + best);
+            entry.row = best_row;
+            entry.source = Mancala::BookSource::Solved;
+            entry.games = 0;
+
+            book[entry.key] = entry;
+            added++;
+        }
+
+        layer.swap(next_layer);
+    }
+
+    return added;
+}
+
+/**
+ * Add the best played move of every position in the first moves of the
+ * games.
+ */
+static size_t add_played(Mancala::GameRecordReader &reader, const unsigned depth,
+    const uint32_t min_games, Book &book)
+{
+    std::unordered_map<uint64_t, MoveStats> stats;
+    Mancala::GameView game;
+
+    while (reader.next(game))
+    {
+        Mancala::BoardState state = Mancala::BoardState::initial(reader.get_n_marbles());
+        Mancala::Side side = Mancala::Side::A;
+
+        for (uint16_t i = 0; i < game.n_moves && i < depth; i++)
+        {
+            const uint8_t row = game.row(i);
+
+            MoveStats &position = stats[state.key(side)];
+            position.games[row]++;
+            position.margin[row] += side == Mancala::Side::A ? game.margin : -game.margin;
+
+            const Mancala::GameState result = Mancala::apply_move(state, side, row);
+
+            if (result == Mancala::GameState::GameOver)
+            {
+                break;
+            }
+
+            side = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+        }
+    }
+
+    size_t added = 0;
+
+    for (const std::pair<const uint64_t, MoveStats> &position : stats)
+    {
+        double best = -1000.0;
+        uint8_t best_row = 0xFF;
+
+        for (uint8_t row = 0; row < Mancala::BoardState::n_rows; row++)
+        {
+            const uint32_t games = position.second.games[row];
+
+            if (games >= min_games && static_cast<double>(position.second.margin[row]) / games > best)
+            {
+                best = static_cast<double>(position.second.margin[row]) / games;
+                best_row = row;
+            }
+        }
+
+        if (best_row == 0xFF || book.find(position.first) != book.end())
+        {
+            continue;
+        }
+
+        Mancala::BookEntry entry;
+        entry.key = position.first;
+        entry.value = static_cast<int16_t>(std::lround(best));
+        entry.row = best_row;
+        entry.source = Mancala::BookSource::Played;
+        entry.games = position.second.games[best_row];
+
+        book[entry.key] = entry;
+        added++;
+    }
+
+    return added;
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: book -o book [-s solution file] [-g game file] [-d plies]\n"
+        "            [-n marbles] [-m games]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    const char *solution_path = NULL;
+    const char *games_path = NULL;
+    unsigned depth = 8;
+    unsigned n_marbles = 0;
+    unsigned min_games = 100;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "o:s:g:d:n:m:")) != -1)
+    {
+        switch (option)
+        {
+            case 'o':
+                path = optarg;
+                break;
+
+            case 's':
+                solution_path = optarg;
+                break;
+
+            case 'g':
+                games_path = optarg;
+                break;
+
+            case 'd':
+                depth = atoi(optarg);
+                break;
+
+            case 'n':
+                n_marbles = atoi(optarg);
+                break;
+
+            case 'm':
+                min_games = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (path == NULL || (solution_path == NULL && games_path == NULL) ||
+        n_marbles > 12u || min_games == 0)
+    {
+        usage();
+        return 1;
+    }
+
+    Mancala::GameRecordReader reader;
+
+    if (games_path != NULL)
+    {
+        if (!reader.open(games_path))
+        {
+            fprintf(stderr, "Error: could not read %s as a game file.\n", games_path);
+            return 1;
+        }
+
+        if (n_marbles != 0 && n_marbles != reader.get_n_marbles())
+        {
+            fprintf(stderr, "Error: %s holds games with %u marbles a hole.\n",
+                games_path, reader.get_n_marbles());
+            return 1;
+        }
+
+        n_marbles = reader.get_n_marbles();
+    }
+
+    if (n_marbles == 0)
+    {
+        n_marbles = 4;
+    }
+
+    Book book;
+
+    if (solution_path != NULL)
+    {
+        Values values;
+        Mancala::SolutionFile file;
+
+        if (!file.open(solution_path, read_record, &values))
+        {
+            fprintf(stderr, "Error: could not open %s as a solution file.\n", solution_path);
+            return 1;
+        }
+
+        file.close();
+
+        printf("%zu solved moves from %zu proven positions.\n",
+            add_solved(values, static_cast<uint8_t>(n_marbles), depth, book), values.size());
+    }
+
+    if (games_path != NULL)
+    {
+        printf("%zu played moves from %llu games.\n",
+            add_played(reader, depth, min_games, book),
+            static_cast<unsigned long long>(reader.size()));
+    }
+
+    std::vector<Mancala::BookEntry> entries;
+    entries.reserve(book.size());
+
+    for (const std::pair<const uint64_t, Mancala::BookEntry> &entry : book)
+    {
+        entries.push_back(entry.second);
+    }
+
+    if (!Mancala::OpeningBook::save(path, static_cast<uint8_t>(n_marbles), entries))
+    {
+        fprintf(stderr, "Error: could not write to %s.\n", path);
+        return 1;
+    }
+
+    printf("Wrote %zu positions to %s.\n", entries.size(), path);
+
+    return 0;
+}
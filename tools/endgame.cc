@@ -0,0 +1,184 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Build, or look positions up in, an endgame database.
+ *
+ * usage: endgame -g marbles [-r] -f file
+ *        endgame -f file -p p0,p1,...,p13 [-s A|B]
+ *
+ *     -g solves every position with up to that many marbles in the holes
+ *        and writes the database to the file, packed unless -r is given.
+ *     -p looks up a position, given as the 14 pit counts in the order of
+ *        Figure 2 of board_state.h, with the side to move given by -s.
+ */
+
+#include "board_state.h"
+#include "endgame_db.h"
+
+#include <chrono>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+/**
+ * Parse a position given as 14 comma separated pit counts.
+ *
+ * @param text The position.
+ * @param[out] state The parsed position.
+ *
+ * @return True if the position is well formed.
+ */
+static bool parse_position(const char *text, Mancala::BoardState &state)
+{
+    state = Mancala::BoardState::initial(0u);
+
+    for (uint8_t i = 0; i < Mancala::BoardState::n_pits; i++)
+    {
+        char *end = NULL;
+        const long n_marbles = strtol(text, &end, 10);
+
+        if (end == text || n_marbles < 0 || n_marbles > 255)
+        {
+            return false;
+        }
+
+        state.pits[i] = static_cast<uint8_t>(n_marbles);
+        text = end;
+
+        if (i + 1u < Mancala::BoardState::n_pits)
+        {
+            if (*text != ',')
+            {
+                return false;
+            }
+
+            text++;
+        }
+    }
+
+    return *text == '\0';
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: endgame -g marbles [-r] -f file\n"
+        "       endgame -f file -p p0,p1,...,p13 [-s A|B]\n");
+}
+
+int main(int argc, char **argv)
+{
+    int n_marbles = -1;
+    const char *path = NULL;
+    const char *position = NULL;
+    Mancala::Side side = Mancala::Side::A;
+    bool packed = true;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "g:rf:p:s:")) != -1)
+    {
+        switch (option)
+        {
+            case 'g':
+                n_marbles = atoi(optarg);
+                break;
+
+            case 'r':
+                packed = false;
+                break;
+
+            case 'f':
+                path = optarg;
+                break;
+
+            case 'p':
+                position = optarg;
+                break;
+
+            case 's':
+                side = optarg[0] == 'B' || optarg[0] == 'b' ? Mancala::Side::B : Mancala::Side::A;
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (path == NULL || (n_marbles < 0) == (position == NULL))
+    {
+        usage();
+        return 1;
+    }
+
+    Mancala::EndgameDatabase database;
+
+    if (n_marbles >= 0)
+    {
+        if (n_marbles > Mancala::EndgameDatabase::max_marbles)
+        {
+            fprintf(stderr, "Error: at most %u marbles.\n", Mancala::EndgameDatabase::max_marbles);
+            return 1;
+        }
+
+        printf("Solving %llu positions with up to %d marbles in the holes...\n",
+            static_cast<unsigned long long>(Mancala::EndgameDatabase::positions(
+                static_cast<uint8_t>(n_marbles))), n_marbles);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        database.generate(static_cast<uint8_t>(n_marbles));
+
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        printf("Solved in %.2fs (%.2f Mpositions/s).\n", seconds, database.size() / seconds / 1e6);
+
+        if (!database.save(path, packed))
+        {
+            fprintf(stderr, "Error: could not write %s.\n", path);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    Mancala::BoardState state;
+
+    if (!parse_position(position, state))
+    {
+        fprintf(stderr, "Error: a position is 14 pit counts.\n");
+        return 1;
+    }
+
+    if (!database.load(path))
+    {
+        fprintf(stderr, "Error: could not read %s.\n", path);
+        return 1;
+    }
+
+    int16_t value = 0;
+
+    if (!database.probe(state, side, value))
+    {
+        printf("Not in the database (more than %d marbles in the holes).\n",
+            database.get_max_marbles());
+        return 1;
+    }
+
+    const int16_t final_difference = static_cast<int16_t>(state.get_home(side)) -
+        static_cast<int16_t>(state.get_home(side == Mancala::Side::A ? Mancala::Side::B : Mancala::Side::A)) +
+        value;
+
+    printf("%c to move gains %+d from here, and finishes %+d: %s.\n",
+        side == Mancala::Side::A ? 'A' : 'B', value, final_difference,
+        final_difference > 0 ? "a win" : final_difference < 0 ? "a loss" : "a tie (won by B)");
+
+    return 0;
+}
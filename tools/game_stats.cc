@@ -0,0 +1,176 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Scan a game file and summarize the games in it.
+ *
+ * Reads every game in place from the mapped file and reports the number
+ * of games and moves, how often each side won, and how fast the file was
+ * scanned. With -v every game is also replayed from the opening, and
+ * checked to be legal and to end where its margin says.
+ *
+ * usage: game_stats -f file [-v] [-g first game] [-c games]
+ */
+
+#include "board_state.h"
+#include "game_record.h"
+#include "sowing.h"
+
+#include <chrono>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+/**
+ * Replay a game and check it against its record.
+ */
+static bool replay(const Mancala::GameView &game, const uint8_t n_marbles)
+{
+    Mancala::BoardState state = Mancala::BoardState::initial(n_marbles);
+    Mancala::Side side = Mancala::Side::A;
+
+    for (uint16_t i = 0; i < game.n_moves; i++)
+    {
+        const Mancala::GameState result = Mancala::apply_move(state, side, game.row(i));
+
+        if (result == Mancala::GameState::EmptyHoleError)
+        {
+            return false;
+        }
+
+        if (result == Mancala::GameState::GameOver)
+        {
+            return i + 1u == game.n_moves &&
+                state.get_home(Mancala::Side::A) - state.get_home(Mancala::Side::B) == game.margin;
+        }
+
+        side = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+    }
+
+    return false;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: game_stats -f file [-v] [-g first game] [-c games]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    bool verify = false;
+    unsigned long long first = 0;
+    unsigned long long count = 0;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "f:vg:c:")) != -1)
+    {
+        switch (option)
+        {
+            case 'f':
+                path = optarg;
+                break;
+
+            case 'v':
+                verify = true;
+                break;
+
+            case 'g':
+                first = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'c':
+                count = strtoull(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (path == NULL)
+    {
+        usage();
+        return 1;
+    }
+
+    Mancala::GameRecordReader reader;
+
+    if (!reader.open(path))
+    {
+        fprintf(stderr, "Error: could not read %s as a game file.\n", path);
+        return 1;
+    }
+
+    printf("%llu games in %llu blocks, %u marbles\n",
+        static_cast<unsigned long long>(reader.size()),
+        static_cast<unsigned long long>(reader.blocks()), reader.get_n_marbles());
+
+    if (first != 0 && !reader.seek(first))
+    {
+        fprintf(stderr, "Error: there is no game %llu.\n", first);
+        return 1;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    uint64_t games = 0;
+    uint64_t moves = 0;
+    uint64_t longest = 0;
+    uint64_t a_wins = 0;
+    uint64_t draws = 0;
+    uint64_t bad = 0;
+    uint64_t checksum = 0;
+
+    Mancala::GameView game;
+
+    while ((count == 0 || games < count) && reader.next(game))
+    {
+        games++;
+        moves += game.n_moves;
+        longest = game.n_moves > longest ? game.n_moves : longest;
+        a_wins += game.margin > 0;
+        draws += game.margin == 0;
+
+        /*
+         * Touch every move, so that the scan is timed decoding them.
+         */
+        for (uint16_t i = 0; i < game.n_moves; i++)
+        {
+            checksum = checksum * 7u + game.row(i);
+        }
+
+        if (verify && !replay(game, reader.get_n_marbles()))
+        {
+            bad++;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    printf("%llu games, %llu moves (%.1f a game, longest %llu)\n",
+        static_cast<unsigned long long>(games), static_cast<unsigned long long>(moves),
+        games != 0 ? static_cast<double>(moves) / games : 0.0,
+        static_cast<unsigned long long>(longest));
+    printf("A won %.2f%%, drew %.2f%%, B won %.2f%%\n",
+        games != 0 ? 100.0 * a_wins / games : 0.0,
+        games != 0 ? 100.0 * draws / games : 0.0,
+        games != 0 ? 100.0 * (games - a_wins - draws) / games : 0.0);
+    printf("%.3fs, %.2f Mgames/s, %.1f Mmoves/s (checksum %016llx)\n",
+        seconds, games / seconds / 1e6, moves / seconds / 1e6,
+        static_cast<unsigned long long>(checksum));
+
+    if (verify)
+    {
+        printf("%llu games failed to replay\n", static_cast<unsigned long long>(bad));
+    }
+
+    return bad != 0;
+}
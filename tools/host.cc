@@ -0,0 +1,136 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Host games for any number of players over the network.
+ *
+ * Runs a GameHost on every core, all sharing a port, reporting the
+ * players connected, the games open, and the games paired by the lobby
+ * and the games and moves played each second. Ctrl-C stops it.
+ *
+ * Players join a game by its id, or ask the lobby for an opponent (see
+ * protocol.h), so this is also the lobby players find one another in.
+ *
+ * usage: host [-p port] [-t threads] [-i seconds]
+ *
+ *     -p the TCP port to listen on (default 6969).
+ *     -t the number of hosts, each on its own thread (default one per
+ *        core).
+ *     -i the seconds between reports (default 1).
+ */
+
+#include "host_group.h"
+
+#include <chrono>
+#include <thread>
+
+#include <csignal>
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_interrupt(int)
+{
+    interrupted = 1;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: host [-p port] [-t threads] [-i seconds]\n");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned port = 6969;
+    unsigned n_threads = 0;
+    unsigned interval = 1;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "p:t:i:")) != -1)
+    {
+        switch (option)
+        {
+            case 'p':
+                port = atoi(optarg);
+                break;
+
+            case 't':
+                n_threads = atoi(optarg);
+                break;
+
+            case 'i':
+                interval = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (port == 0 || port > 65535 || interval == 0)
+    {
+        usage();
+        return 1;
+    }
+
+    signal(SIGINT, on_interrupt);
+    signal(SIGTERM, on_interrupt);
+
+    Mancala::HostGroup host(static_cast<uint16_t>(port), n_threads);
+
+    if (!host.start())
+    {
+        fprintf(stderr, "Error: could not listen on port %u.\n", port);
+        return 1;
+    }
+
+    printf("Listening on port %u with %u threads.\n\n", port, host.get_threads());
+    fflush(stdout);
+
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point last = Clock::now();
+    uint64_t last_matched = 0;
+    uint64_t last_finished = 0;
+    uint64_t last_moves = 0;
+
+    while (!interrupted)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const Clock::time_point now = Clock::now();
+        const double seconds = std::chrono::duration<double>(now - last).count();
+
+        if (seconds < interval)
+        {
+            continue;
+        }
+
+        const uint64_t matched = host.get_matched();
+        const uint64_t finished = host.get_finished();
+        const uint64_t moves = host.get_moves();
+
+        printf("%8zu players  %8zu games  %10.0f matches/s  %10.0f games/s  %10.0f moves/s\n",
+            host.get_players(), host.get_games(), (matched - last_matched) / seconds,
+            (finished - last_finished) / seconds, (moves - last_moves) / seconds);
+        fflush(stdout);
+
+        last = now;
+        last_matched = matched;
+        last_finished = finished;
+        last_moves = moves;
+    }
+
+    host.stop();
+
+    printf("Stopped after %llu games.\n", static_cast<unsigned long long>(host.get_finished()));
+
+    return 0;
+}
@@ -0,0 +1,780 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Load a game host with many simultaneous games.
+ *
+ * Opens two connections for each of a number of tables, joins both to
+ * the same game, one on each side, and plays random legal moves until the
+ * game ends, then joins the next. Every connection is driven from one
+ * epoll loop, as the host drives its own. Reports the games and moves
+ * played each second, and the number of games in play. Every State the
+ * host sends for an opponent's move is checked against the seat's own
+ * copy of the board, and any difference is counted as a desync.
+ *
+ * Each table needs two descriptors here and two in the host, so raise
+ * the limit (ulimit -n) for more than a few hundred tables.
+ *
+ * With -m the players find one another through the host's lobby rather
+ * than joining games by id: every connection seeks an opponent, plays
+ * whoever it is paired with on whichever side it is given, and seeks
+ * again once the game ends. The time from each Seek to its Match is
+ * measured, and its percentiles reported at the end.
+ *
+ * With -w each table is also watched by a number of spectators, which
+ * watch each of its games from the moment it starts and check every
+ * State against their own copy of the board. With -z some of them never
+ * read at all, to show that a stalled spectator holds up no game.
+ *
+ * With -H the host runs in this process, as a HostGroup of the given
+ * number of threads listening on the port, so a single command loads
+ * the whole server.
+ *
+ * usage: host_load [-a address] [-p port] [-c tables] [-g games] [-s seed]
+ *                  [-i seconds] [-H threads] [-m] [-w spectators] [-z stalled]
+ *
+ *     -a the host's IPv4 address (default 127.0.0.1).
+ *     -p the host's port (default 6969).
+ *     -c the number of games played at once (default 1000).
+ *     -g the number of games to play in all (default 100000).
+ *     -s the random seed (default 0).
+ *     -i the seconds between reports (default 1).
+ *     -H host the games in this process, on this many threads.
+ *     -m pair the players through the lobby.
+ *     -w the number of spectators of each table (default 0).
+ *     -z the number of those spectators that never read (default 0).
+ */
+
+#include "board_state.h"
+#include "connection.h"
+#include "event_loop.h"
+#include "host_group.h"
+#include "protocol.h"
+#include "random.h"
+#include "sowing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <csignal>
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace Mancala;
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_interrupt(int)
+{
+    interrupted = 1;
+}
+
+struct Table;
+
+/**
+ * One side of a table: a connection and its copy of the game.
+ */
+struct Seat
+{
+    Seat(int fd, Table *_table) :
+        connection(fd), table(_table), side(Side::A), turn(Side::A), round(0), playing(false),
+        writing(false), watching(false)
+    {
+    }
+
+    Connection connection;
+    Table *table;
+    BoardState state;
+    Side side;
+    Side turn;
+    uint16_t round;
+    bool playing;
+    bool writing;
+
+    /**
+     * When the seat last asked the lobby for an opponent.
+     */
+    Clock::time_point sought;
+
+    /**
+     * True for a spectator.
+     */
+    bool watching;
+};
+
+/**
+ * The two seats of a game.
+ */
+struct Table
+{
+    Table() : game_id(0)
+    {
+    }
+
+    std::unique_ptr<Seat> seats[2];
+
+    /**
+     * The spectators, the stalled ones first.
+     */
+    std::vector<std::unique_ptr<Seat>> watchers;
+
+    /**
+     * The game being played.
+     */
+    uint32_t game_id;
+};
+
+/**
+ * Everything the event loop needs.
+ */
+struct Load
+{
+    Load() :
+        next_id(1), to_start(0), started(0), finished(0), errors(0), desyncs(0), moves(0),
+        states_watched(0), games_missed(0), lobby(false),
+        sought(0), matched(0), ended(0)
+    {
+    }
+
+    EventLoop loop;
+    Random random;
+    std::vector<Table> tables;
+    uint32_t next_id;
+    uint64_t to_start;
+    uint64_t started;
+    uint64_t finished;
+    uint64_t errors;
+    uint64_t desyncs;
+    uint64_t moves;
+
+    /**
+     * The States received by spectators, and the games that ended before
+     * a spectator's Watch arrived.
+     */
+    uint64_t states_watched;
+    uint64_t games_missed;
+
+    /**
+     * True to pair the seats through the lobby.
+     */
+    bool lobby;
+
+    /**
+     * The seeks sent, matches received and games ended, counted by seat.
+     */
+    uint64_t sought;
+    uint64_t matched;
+    uint64_t ended;
+
+    /**
+     * The time from each Seek to its Match, in microseconds.
+     */
+    std::vector<uint32_t> pairing_us;
+};
+
+static int connect_to(const struct sockaddr_in &address)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (connect(fd, reinterpret_cast<const struct sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    const int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    return fd;
+}
+
+/**
+ * Write out a seat's messages, watching for room to write if some are
+ * left.
+ */
+static bool flush(Load &load, Seat &seat)
+{
+    if (!seat.connection.flush())
+    {
+        return false;
+    }
+
+    const bool writing = seat.connection.wants_write();
+
+    if (writing == seat.writing)
+    {
+        return true;
+    }
+
+    seat.writing = writing;
+
+    return load.loop.modify(seat.connection.get_fd(),
+        EPOLLIN | (writing ? EPOLLOUT : 0u), &seat);
+}
+
+/**
+ * Join both seats of a table to the next game, if any are left.
+ */
+static void join(Load &load, Table &table)
+{
+    if (load.to_start == 0)
+    {
+        return;
+    }
+
+    load.to_start--;
+    load.started++;
+
+    const uint32_t game_id = load.next_id++;
+    table.game_id = game_id;
+
+    for (unsigned s = 0; s < 2u; s++)
+    {
+        Seat &seat = *table.seats[s];
+
+        uint8_t payload[5];
+        write_u32(payload, game_id);
+        payload[4] = static_cast<uint8_t>(s == 0 ? Side::A : Side::B);
+
+        seat.side = s == 0 ? Side::A : Side::B;
+        seat.playing = true;
+        seat.connection.send(MessageType::JoinMessage, payload, sizeof(payload));
+    }
+}
+
+/**
+ * Ask the lobby for the seat's next opponent, if any games are left.
+ * Each game takes two seeks, so to_start counts seeks here.
+ */
+static void seek(Load &load, Seat &seat)
+{
+    if (load.to_start == 0)
+    {
+        return;
+    }
+
+    load.to_start--;
+    load.sought++;
+
+    seat.playing = true;
+    seat.sought = Clock::now();
+    seat.connection.send(MessageType::SeekMessage, NULL, 0);
+}
+
+/**
+ * Have a table's spectators watch its game.
+ */
+static void watch(Load &load, Table &table)
+{
+    uint8_t payload[4];
+    write_u32(payload, table.game_id);
+
+    for (const std::unique_ptr<Seat> &watcher : table.watchers)
+    {
+        watcher->connection.send(MessageType::WatchMessage, payload, sizeof(payload));
+        flush(load, *watcher);
+    }
+}
+
+/**
+ * Handle a State sent to a spectator, checking it against the
+ * spectator's own copy of the board.
+ */
+static void on_watched(Load &load, Seat &seat, const Frame &frame)
+{
+    uint16_t round;
+    Side side;
+    uint8_t row;
+    GameState next;
+
+    load.states_watched++;
+
+    /*
+     * The whole board, when the spectator starts or has caught up.
+     */
+    if (!decode_state(frame, round, side, row, next, NULL) || row == no_row)
+    {
+        decode_state(frame, round, side, row, next, &seat.state);
+        return;
+    }
+
+    const GameState result = apply_move(seat.state, side, row);
+
+    BoardState hosted = seat.state;
+    decode_state(frame, round, side, row, next, &hosted);
+
+    if (next != result || memcmp(&hosted, &seat.state, sizeof(hosted)) != 0)
+    {
+        load.desyncs++;
+        seat.state = hosted;
+    }
+}
+
+/**
+ * Play a seat's moves for as long as it is its turn.
+ */
+static void play(Load &load, Seat &seat)
+{
+    while (seat.turn == seat.side)
+    {
+        const uint8_t row = load.random.pick(seat.state.legal_moves(seat.side));
+        const GameState result = apply_move(seat.state, seat.side, row);
+
+        uint8_t payload[4];
+        encode_move(payload, ++seat.round, seat.side, row);
+        seat.connection.send(MessageType::MoveMessage, payload, sizeof(payload));
+        load.moves++;
+
+        if (result == GameState::GameOver)
+        {
+            return;
+        }
+
+        seat.turn = result == GameState::SideA ? Side::A : Side::B;
+    }
+}
+
+/**
+ * Handle a message to a seat.
+ *
+ * @return False if the table's game is over.
+ */
+static bool on_frame(Load &load, Seat &seat, const Frame &frame)
+{
+    if (seat.watching)
+    {
+        if (frame.type == MessageType::StateMessage)
+        {
+            on_watched(load, seat, frame);
+        }
+        else if (frame.type == MessageType::ErrorMessage && frame.length == 1u &&
+            frame.payload[0] == HostError::NoGameError)
+        {
+            load.games_missed++;
+        }
+        else if (frame.type != MessageType::EndMessage)
+        {
+            load.errors++;
+        }
+
+        return true;
+    }
+
+    switch (frame.type)
+    {
+        case MessageType::MatchMessage:
+        {
+            load.pairing_us.push_back(static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - seat.sought).count()));
+
+            seat.side = static_cast<Side>(frame.payload[4] != 0);
+
+            if (++load.matched % 2u == 0)
+            {
+                load.started++;
+            }
+
+            return true;
+        }
+
+        case MessageType::StartMessage:
+        {
+            seat.state = BoardState::initial(frame.payload[4]);
+            seat.turn = Side::A;
+            seat.round = 0;
+
+            if (&seat == seat.table->seats[0].get())
+            {
+                watch(load, *seat.table);
+            }
+
+            play(load, seat);
+            return true;
+        }
+
+        case MessageType::StateMessage:
+        {
+            uint16_t round;
+            Side side;
+            uint8_t row;
+            GameState next;
+
+            if (!decode_state(frame, round, side, row, next, NULL))
+            {
+                load.errors++;
+                return false;
+            }
+
+            /*
+             * The seat's own moves come back too, and are played already.
+             */
+            if (side == seat.side)
+            {
+                return true;
+            }
+
+            const GameState result = apply_move(seat.state, side, row);
+            seat.round++;
+
+            /*
+             * The host's board must agree with this one after each of the
+             * opponent's moves.
+             */
+            BoardState hosted = seat.state;
+            decode_state(frame, round, side, row, next, &hosted);
+
+            if (round != seat.round || next != result ||
+                memcmp(&hosted, &seat.state, sizeof(hosted)) != 0)
+            {
+                load.desyncs++;
+            }
+
+            if (result != GameState::GameOver)
+            {
+                seat.turn = result == GameState::SideA ? Side::A : Side::B;
+                play(load, seat);
+            }
+
+            return true;
+        }
+
+        case MessageType::EndMessage:
+        {
+            return false;
+        }
+
+        default:
+        {
+            load.errors++;
+            return false;
+        }
+    }
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: host_load [-a address] [-p port] [-c tables] [-g games] [-s seed]\n"
+        "                 [-i seconds] [-H threads] [-m] [-w spectators] [-z stalled]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = "127.0.0.1";
+    unsigned port = 6969;
+    unsigned n_tables = 1000;
+    unsigned long long n_games = 100000u;
+    unsigned long long seed = 0;
+    unsigned interval = 1;
+    unsigned host_threads = 0;
+    bool lobby = false;
+    unsigned n_watchers = 0;
+    unsigned n_stalled = 0;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "a:p:c:g:s:i:H:mw:z:")) != -1)
+    {
+        switch (option)
+        {
+            case 'a':
+                host = optarg;
+                break;
+
+            case 'p':
+                port = atoi(optarg);
+                break;
+
+            case 'c':
+                n_tables = atoi(optarg);
+                break;
+
+            case 'g':
+                n_games = strtoull(optarg, NULL, 10);
+                break;
+
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'i':
+                interval = atoi(optarg);
+                break;
+
+            case 'H':
+                host_threads = atoi(optarg);
+                break;
+
+            case 'm':
+                lobby = true;
+                break;
+
+            case 'w':
+                n_watchers = atoi(optarg);
+                break;
+
+            case 'z':
+                n_stalled = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (port == 0 || port > 65535 || n_tables == 0 || interval == 0 ||
+        n_stalled > n_watchers || (lobby && n_watchers != 0) ||
+        inet_pton(AF_INET, host, &address.sin_addr) != 1)
+    {
+        usage();
+        return 1;
+    }
+
+    signal(SIGINT, on_interrupt);
+    signal(SIGTERM, on_interrupt);
+
+    std::unique_ptr<HostGroup> hosts;
+
+    if (host_threads != 0)
+    {
+        hosts.reset(new HostGroup(static_cast<uint16_t>(port), host_threads));
+
+        if (!hosts->start())
+        {
+            fprintf(stderr, "Error: could not listen on port %u.\n", port);
+            return 1;
+        }
+    }
+
+    Load load;
+    load.random = Random(seed);
+    load.lobby = lobby;
+    load.to_start = lobby ? 2u * n_games : n_games;
+    load.tables.resize(n_tables);
+
+    for (Table &table : load.tables)
+    {
+        for (unsigned s = 0; s < 2u; s++)
+        {
+            const int fd = connect_to(address);
+
+            if (fd < 0)
+            {
+                fprintf(stderr, "Error: could not connect to %s:%u.\n", host, port);
+                return 1;
+            }
+
+            table.seats[s].reset(new Seat(fd, &table));
+            load.loop.add(fd, EPOLLIN, table.seats[s].get());
+        }
+
+        for (unsigned w = 0; w < n_watchers; w++)
+        {
+            const int fd = connect_to(address);
+
+            if (fd < 0)
+            {
+                fprintf(stderr, "Error: could not connect to %s:%u.\n", host, port);
+                return 1;
+            }
+
+            table.watchers.emplace_back(new Seat(fd, &table));
+
+            Seat &watcher = *table.watchers.back();
+            watcher.watching = true;
+            watcher.playing = true;
+
+            /*
+             * A stalled spectator is never read, so never polled.
+             */
+            if (w >= n_stalled)
+            {
+                load.loop.add(fd, EPOLLIN, &watcher);
+            }
+        }
+
+        if (lobby)
+        {
+            continue;
+        }
+
+        join(load, table);
+
+        for (unsigned s = 0; s < 2u; s++)
+        {
+            flush(load, *table.seats[s]);
+        }
+    }
+
+    /*
+     * Seek only once every seat is connected, so that connecting the rest
+     * is not counted in the time the first seats wait for a match.
+     */
+    for (Table &table : load.tables)
+    {
+        for (unsigned s = 0; lobby && s < 2u; s++)
+        {
+            seek(load, *table.seats[s]);
+            flush(load, *table.seats[s]);
+        }
+    }
+
+    printf("%u tables, %llu games%s\n\n", n_tables, n_games, lobby ? " through the lobby" : "");
+    fflush(stdout);
+
+    const Clock::time_point start = Clock::now();
+    Clock::time_point last = start;
+    uint64_t last_finished = 0;
+    uint64_t last_moves = 0;
+
+    std::vector<ReadyEvent> ready;
+
+    while (!interrupted &&
+        (lobby ? load.ended < load.sought : load.finished < load.started))
+    {
+        if (load.loop.wait(ready, 100) < 0)
+        {
+            fprintf(stderr, "Error: the event loop failed.\n");
+            return 1;
+        }
+
+        for (const ReadyEvent &event : ready)
+        {
+            Seat &seat = *static_cast<Seat *>(event.tag);
+
+            if ((event.events & EPOLLIN) && !seat.connection.receive())
+            {
+                fprintf(stderr, "Error: the host closed a connection.\n");
+                return 1;
+            }
+
+            Frame frame;
+
+            while (seat.playing && seat.connection.next(frame))
+            {
+                if (on_frame(load, seat, frame))
+                {
+                    continue;
+                }
+
+                seat.playing = false;
+
+                /*
+                 * Through the lobby, seats play on their own, and each
+                 * seeks again as soon as its game ends.
+                 */
+                if (lobby)
+                {
+                    if (++load.ended % 2u == 0)
+                    {
+                        load.finished++;
+                    }
+
+                    seek(load, seat);
+                    continue;
+                }
+
+                /*
+                 * Start the table's next game once both seats heard the
+                 * end of the last one.
+                 */
+                Table &table = *seat.table;
+
+                if (!table.seats[0]->playing && !table.seats[1]->playing)
+                {
+                    load.finished++;
+                    join(load, table);
+                }
+            }
+
+            for (const std::unique_ptr<Seat> &table_seat : seat.table->seats)
+            {
+                if (!flush(load, *table_seat))
+                {
+                    fprintf(stderr, "Error: could not write to the host.\n");
+                    return 1;
+                }
+            }
+
+            if (seat.watching && !flush(load, seat))
+            {
+                fprintf(stderr, "Error: could not write to the host.\n");
+                return 1;
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        const double seconds = std::chrono::duration<double>(now - last).count();
+
+        if (seconds >= interval)
+        {
+            printf("%12llu games  %10.0f games/s  %10.0f moves/s  %8llu in play\n",
+                static_cast<unsigned long long>(load.finished),
+                (load.finished - last_finished) / seconds,
+                (load.moves - last_moves) / seconds,
+                static_cast<unsigned long long>(load.started - load.finished));
+            fflush(stdout);
+
+            last = now;
+            last_finished = load.finished;
+            last_moves = load.moves;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    printf("\n%llu games, %llu moves in %.2f s: %.0f games/s, %.0f moves/s, %llu errors, "
+        "%llu desyncs\n",
+        static_cast<unsigned long long>(load.finished),
+        static_cast<unsigned long long>(load.moves), seconds,
+        load.finished / seconds, load.moves / seconds,
+        static_cast<unsigned long long>(load.errors),
+        static_cast<unsigned long long>(load.desyncs));
+
+    if (n_watchers != 0)
+    {
+        printf("spectators: %u per table, %u stalled, %llu states watched (%.0f/s), "
+            "%llu games missed\n",
+            n_watchers, n_stalled, static_cast<unsigned long long>(load.states_watched),
+            load.states_watched / seconds, static_cast<unsigned long long>(load.games_missed));
+    }
+
+    std::vector<uint32_t> &pairing = load.pairing_us;
+
+    if (!pairing.empty())
+    {
+        std::sort(pairing.begin(), pairing.end());
+
+        printf("pairing: %zu matches, %.2f ms median, %.2f ms p99, %.2f ms max\n",
+            pairing.size(), pairing[pairing.size() / 2u] / 1000.0,
+            pairing[pairing.size() * 99u / 100u] / 1000.0, pairing.back() / 1000.0);
+    }
+
+    return 0;
+}
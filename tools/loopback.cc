@@ -0,0 +1,316 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Play games between two GameServers in one process.
+ *
+ * Two threads each open a GameServer to the other over the loopback
+ * interface, one on each side, and play random legal moves against each
+ * other. Each keeps its own copy of the board, and checks every move it
+ * receives is from the side to move, for the next round, and from a row
+ * that is not empty. Over the lobby transport a host runs in this
+ * process too, as a HostGroup, and each received move is also checked
+ * against the host's board and state. Reports the moves played each
+ * second once every game is over.
+ *
+ * usage: loopback [-t duplex|lobby] [-p port] [-g games] [-s seed]
+ *
+ *     -t the transport (default duplex).
+ *     -p the game port (default 7310).
+ *     -g the number of games (default 2000).
+ *     -s the random seed (default 0).
+ */
+
+#include "board_state.h"
+#include "game_server.h"
+#include "host_group.h"
+#include "random.h"
+#include "sowing.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+/**
+ * One player's half of the run.
+ */
+struct Player
+{
+    /**
+     * The side asked for. The lobby picks its own.
+     */
+    Mancala::Side side;
+
+    /**
+     * The seed of this player's moves.
+     */
+    uint64_t seed;
+
+    /**
+     * The moves played by both sides, as this player saw them.
+     */
+    uint64_t moves;
+
+    /**
+     * Why the player stopped early, or NULL if every game was played.
+     */
+    const char *error;
+};
+
+/**
+ * Everything the players share, set before they start.
+ */
+struct Loopback
+{
+    Mancala::Transport transport;
+    uint16_t port;
+    unsigned long long n_games;
+};
+
+/**
+ * Play one game on a connection, from the opening.
+ *
+ * @param[in,out] round The round of the last move either side sent,
+ *                carried from game to game on one connection.
+ *
+ * @return NULL, or why the game could not be finished.
+ */
+static const char *play_game(Mancala::GameServer &server, const bool refereed,
+    Mancala::Random &random, uint16_t &round, uint64_t &moves)
+{
+    const Mancala::Side own_side = server.get_side();
+    Mancala::BoardState state = Mancala::BoardState::initial();
+    Mancala::Side turn = Mancala::Side::A;
+
+    while (true)
+    {
+        Mancala::GameState result;
+
+        if (turn == own_side)
+        {
+            const uint8_t row = random.pick(state.legal_moves(own_side));
+
+            result = Mancala::apply_move(state, own_side, row);
+
+            if (!server.send_move(++round, own_side, row))
+            {
+                return "a move could not be sent";
+            }
+        }
+        else
+        {
+            if (server.wait_move() != Mancala::MoveWait::MoveReady)
+            {
+                return "the opponent left";
+            }
+
+            uint16_t received_round;
+            Mancala::Side side;
+            uint8_t row;
+
+            server.get_move(received_round, side, row);
+
+            if (side != turn || received_round != static_cast<uint16_t>(round + 1u) ||
+                row >= Mancala::BoardState::n_rows)
+            {
+                return "a move arrived out of turn";
+            }
+
+            round = received_round;
+            result = Mancala::apply_move(state, side, row);
+
+            if (result == Mancala::GameState::EmptyHoleError)
+            {
+                return "a move arrived from an empty row";
+            }
+
+            if (refereed)
+            {
+                Mancala::BoardState hosted;
+                Mancala::GameState next;
+
+                server.get_host_state(hosted, next);
+
+                if (hosted != state || next != result)
+                {
+                    return "the host's board differs";
+                }
+            }
+        }
+
+        moves++;
+
+        if (result == Mancala::GameState::GameOver)
+        {
+            return NULL;
+        }
+
+        turn = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+    }
+}
+
+/**
+ * Play every game as one player.
+ */
+static void play(const Loopback *loopback, Player *player)
+{
+    char hostname[] = "127.0.0.1";
+    Mancala::Random random(player->seed);
+    std::unique_ptr<Mancala::GameServer> server;
+    uint16_t round = 0;
+
+    for (unsigned long long game = 0; game < loopback->n_games && player->error == NULL; game++)
+    {
+        /*
+         * The lobby pairs players for a game at a time, and a host's
+         * rounds start again with each game.
+         */
+        if (server == NULL || loopback->transport == Mancala::Transport::LobbyTransport)
+        {
+            server.reset(new Mancala::GameServer(hostname, player->side, loopback->port,
+                loopback->transport));
+            round = 0;
+
+            if (!server->is_connected())
+            {
+                player->error = "could not connect";
+                return;
+            }
+        }
+
+        player->error = play_game(*server,
+            loopback->transport == Mancala::Transport::LobbyTransport,
+            random, round, player->moves);
+    }
+}
+
+/**
+ * Print the usage.
+ */
+static void usage()
+{
+    fprintf(stderr, "usage: loopback [-t duplex|lobby] [-p port] [-g games] [-s seed]\n");
+}
+
+int main(int argc, char **argv)
+{
+    Loopback loopback;
+    loopback.transport = Mancala::Transport::DuplexTransport;
+    loopback.port = 7310u;
+    loopback.n_games = 2000ull;
+
+    unsigned long long seed = 0;
+    unsigned port = loopback.port;
+    int option;
+
+    while ((option = getopt(argc, argv, "t:p:g:s:")) != -1)
+    {
+        switch (option)
+        {
+            case 't':
+                if (strcmp(optarg, "duplex") == 0)
+                {
+                    loopback.transport = Mancala::Transport::DuplexTransport;
+                }
+                else if (strcmp(optarg, "lobby") == 0)
+                {
+                    loopback.transport = Mancala::Transport::LobbyTransport;
+                }
+                else
+                {
+                    usage();
+                    return 1;
+                }
+                break;
+
+            case 'p':
+                port = atoi(optarg);
+                break;
+
+            case 'g':
+                loopback.n_games = strtoull(optarg, NULL, 10);
+                break;
+
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (port == 0 || port > 65535)
+    {
+        usage();
+        return 1;
+    }
+
+    loopback.port = static_cast<uint16_t>(port);
+
+    std::unique_ptr<Mancala::HostGroup> hosts;
+
+    if (loopback.transport == Mancala::Transport::LobbyTransport)
+    {
+        hosts.reset(new Mancala::HostGroup(loopback.port, 1u));
+
+        if (!hosts->start())
+        {
+            fprintf(stderr, "Error: could not listen on port %u.\n", port);
+            return 1;
+        }
+    }
+
+    Player players[2];
+
+    for (uint8_t i = 0; i < 2u; i++)
+    {
+        players[i].side = i == 0 ? Mancala::Side::A : Mancala::Side::B;
+        players[i].seed = seed * 2u + i;
+        players[i].moves = 0;
+        players[i].error = NULL;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::thread a(play, &loopback, &players[0]);
+    std::thread b(play, &loopback, &players[1]);
+
+    a.join();
+    b.join();
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (uint8_t i = 0; i < 2u; i++)
+    {
+        if (players[i].error != NULL)
+        {
+            fprintf(stderr, "Error: player %u stopped: %s.\n", i + 1u, players[i].error);
+            return 1;
+        }
+    }
+
+    if (players[0].moves != players[1].moves)
+    {
+        fprintf(stderr, "Error: the players saw %llu and %llu moves.\n",
+            static_cast<unsigned long long>(players[0].moves),
+            static_cast<unsigned long long>(players[1].moves));
+        return 1;
+    }
+
+    printf("\n%llu games, %llu moves in %.2fs: %.0f moves/s.\n", loopback.n_games,
+        static_cast<unsigned long long>(players[0].moves), seconds,
+        players[0].moves / seconds);
+
+    return 0;
+}
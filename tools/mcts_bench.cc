@@ -0,0 +1,83 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Measure the playout throughput of the Monte Carlo search.
+ *
+ * Searches the opening of Board<4u> for a fixed number of playouts with
+ * playouts run one at a time and in batches of 8, 32 and 128, and then
+ * with 1, 2, 4, ... threads at the chosen batch size. Reports playouts
+ * per second for each core, the engine's headline rate.
+ *
+ * usage: mcts_bench [playouts] [max threads] [batch] [arena megabytes]
+ */
+
+#include "board_state.h"
+#include "mcts.h"
+
+#include <thread>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Run one search and print a line of the report.
+ */
+static void run(Mancala::MonteCarloSearch &search, const uint64_t playouts,
+    const unsigned threads, const uint16_t batch)
+{
+    Mancala::MonteCarloLimits limits;
+    limits.playouts = playouts;
+    limits.threads = static_cast<uint8_t>(threads);
+    limits.batch = batch;
+
+    const Mancala::MonteCarloResult result =
+        search.think(Mancala::BoardState::initial(), Mancala::Side::A, limits);
+
+    printf("%7u  %5u  %3u  %6.3f  %10llu  %9zu  %8.3f  %12.0f  %14.0f\n",
+        threads, batch, result.row, result.win_rate,
+        static_cast<unsigned long long>(result.playouts), result.nodes,
+        result.seconds, result.playouts / result.seconds, result.playouts_per_core);
+}
+
+int main(int argc, char **argv)
+{
+    const uint64_t playouts = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000u;
+    unsigned max_threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+    const uint16_t batch = static_cast<uint16_t>(argc > 3 ? atoi(argv[3]) : 32);
+    const size_t megabytes = argc > 4 ? atoi(argv[4]) : 256u;
+
+    if (max_threads == 0)
+    {
+        max_threads = 1;
+    }
+
+    if (max_threads > 255)
+    {
+        max_threads = 255;
+    }
+
+    Mancala::MonteCarloSearch search(megabytes);
+
+    printf("%llu playouts, %zu arena nodes\n\n",
+        static_cast<unsigned long long>(playouts), search.capacity());
+    printf("threads  batch  row     win    playouts      nodes   seconds    playouts/s  playouts/s/core\n");
+
+    static const uint16_t batches[] = {1u, 8u, 32u, 128u};
+
+    for (uint8_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++)
+    {
+        run(search, playouts, 1, batches[i]);
+    }
+
+    printf("\n");
+
+    for (unsigned threads = 1; threads <= max_threads;
+        threads = threads < max_threads && threads * 2 > max_threads ? max_threads : threads * 2)
+    {
+        run(search, playouts, threads, batch);
+    }
+
+    return 0;
+}
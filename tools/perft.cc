@@ -0,0 +1,391 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Count the positions reachable in a number of moves, to time and
+ *        check move generation.
+ *
+ * A perft walk plays every legal move from a position, to a fixed depth,
+ * and counts the leaves: the positions reached after exactly depth moves,
+ * plus the positions where the game ended sooner. A move that ends in the
+ * mover's home is followed by another move of the same side, and counts as
+ * one ply like any other. Alongside the count, the walk sums the Zobrist
+ * keys of the leaves, which catches a changed position even when the
+ * number of positions stays the same. Leaves where the game is over are
+ * keyed with A to move.
+ *
+ * The walk can be run on either engine:
+ *
+ *     flat: apply_move on a copied BoardState (the search engine's path).
+ *     game: Game::make_move and Game::unmake_move on a Board<4u>.
+ *
+ * In golden mode, the opening is walked to each depth in turn (up to 10,
+ * or up to 13 with -d) on both engines, and the results are checked
+ * against counts recorded from the original per-marble Game::run_round.
+ * Any change to move application can be checked and timed by running:
+ *
+ *     ./perft -g
+ *
+ * usage: perft [-d depth] [-s A|B] [-p p0,p1,...,p13] [-e flat|game]
+ *              [-k scalar|sse2] [-g]
+ *
+ *     -p sets the position, as the 14 pit counts in the order of Figure 2
+ *        of board_state.h. The default is the opening.
+ *     -k picks the sowing kernel. The default is the fastest supported.
+ */
+
+#include "board.h"
+#include "board_state.h"
+#include "game.h"
+#include "sowing.h"
+
+#include <chrono>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+/**
+ * The result of a perft walk.
+ */
+struct PerftCount
+{
+    /**
+     * The number of leaves.
+     */
+    uint64_t leaves;
+
+    /**
+     * The sum of the leaves' keys.
+     */
+    uint64_t checksum;
+};
+
+/**
+ * The results of the original Game::run_round from the opening, A to move.
+ */
+static const struct
+{
+    uint8_t depth;
+    uint64_t leaves;
+    uint64_t checksum;
+} golden[] =
+{
+    { 1,            6ull, 0xed13a10e6b69bbb5ull},
+    { 2,           35ull, 0x312f6d03deae20aaull},
+    { 3,          185ull, 0x1d08371fcd1a4c51ull},
+    { 4,          942ull, 0x4944358b89943e1cull},
+    { 5,         4685ull, 0x0fb546c44fd83013ull},
+    { 6,        23169ull, 0x29fa72c3cdf50752ull},
+    { 7,       113959ull, 0x60f402bcc726d453ull},
+    { 8,       559885ull, 0xb1e2b1621fe63821ull},
+    { 9,      2743126ull, 0x9590b7ba9679a514ull},
+    {10,     13394139ull, 0x47071188416d4440ull},
+    {11,     65110578ull, 0x3745b82c0639a98bull},
+    {12,    314268576ull, 0xd17d17acee9161f2ull},
+    {13,   1505517421ull, 0xbb21fb4e05c1d723ull},
+};
+
+static const uint8_t n_golden = sizeof(golden) / sizeof(golden[0]);
+
+/**
+ * The deepest golden count checked unless -d asks for more.
+ */
+static const uint8_t default_golden_depth = 10u;
+
+/**
+ * Get the side that moves next after a move.
+ */
+static inline Mancala::Side next_side(const Mancala::GameState result)
+{
+    return result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+}
+
+/**
+ * Walk a flat state.
+ */
+static void perft_flat(const Mancala::BoardState &state, const Mancala::Side side,
+    const uint8_t depth, PerftCount &count)
+{
+    if (depth == 0)
+    {
+        count.leaves++;
+        count.checksum += state.key(side);
+        return;
+    }
+
+    for (uint8_t row : state.legal_moves(side))
+    {
+        Mancala::BoardState child = state;
+        const Mancala::GameState result = Mancala::apply_move(child, side, row);
+
+        if (result == Mancala::GameState::GameOver)
+        {
+            count.leaves++;
+            count.checksum += child.key(Mancala::Side::A);
+        }
+        else
+        {
+            perft_flat(child, next_side(result), depth - 1u, count);
+        }
+    }
+}
+
+/**
+ * Walk a game, making and taking back each move on its board.
+ */
+static void perft_game(Mancala::Game &game, const Mancala::Board<> &board,
+    const Mancala::Side side, const uint8_t depth, PerftCount &count)
+{
+    if (depth == 0)
+    {
+        count.leaves++;
+        count.checksum += board.get_key(side);
+        return;
+    }
+
+    for (uint8_t row : game.legal_moves(side))
+    {
+        Mancala::GameUndo undo;
+        const Mancala::GameState result = game.make_move(side, row, undo);
+
+        if (result == Mancala::GameState::GameOver)
+        {
+            count.leaves++;
+            count.checksum += board.get_key(Mancala::Side::A);
+        }
+        else
+        {
+            perft_game(game, board, next_side(result), depth - 1u, count);
+        }
+
+        game.unmake_move(undo);
+    }
+}
+
+/**
+ * Walk a position on one of the engines, and time it.
+ *
+ * @param state The position.
+ * @param side The side to move.
+ * @param depth The number of plies to walk.
+ * @param use_game True to walk with Game, false to walk flat states.
+ * @param[out] seconds The time the walk took.
+ *
+ * @return The leaves found.
+ */
+static PerftCount perft(const Mancala::BoardState &state, const Mancala::Side side,
+    const uint8_t depth, const bool use_game, double &seconds)
+{
+    PerftCount count;
+    count.leaves = 0;
+    count.checksum = 0;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (use_game)
+    {
+        Mancala::Board<> board;
+        state.to_board(board);
+
+        Mancala::Game game(board);
+        perft_game(game, board, side, depth, count);
+    }
+    else
+    {
+        perft_flat(state, side, depth, count);
+    }
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return count;
+}
+
+/**
+ * Parse a position given as 14 comma separated pit counts.
+ *
+ * @param text The position.
+ * @param[out] state The parsed position.
+ *
+ * @return True if the position is well formed.
+ */
+static bool parse_position(const char *text, Mancala::BoardState &state)
+{
+    state = Mancala::BoardState::initial(0u);
+    unsigned total = 0;
+
+    for (uint8_t i = 0; i < Mancala::BoardState::n_pits; i++)
+    {
+        char *end = NULL;
+        const long n_marbles = strtol(text, &end, 10);
+
+        if (end == text || n_marbles < 0 || n_marbles > Mancala::Zobrist::max_marbles)
+        {
+            return false;
+        }
+
+        state.pits[i] = static_cast<uint8_t>(n_marbles);
+        total += static_cast<unsigned>(n_marbles);
+
+        text = end;
+
+        if (i + 1u < Mancala::BoardState::n_pits)
+        {
+            if (*text != ',')
+            {
+                return false;
+            }
+
+            text++;
+        }
+    }
+
+    return *text == '\0' && total <= Mancala::Zobrist::max_marbles;
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: perft [-d depth] [-s A|B] [-p p0,p1,...,p13] [-e flat|game]\n"
+        "             [-k scalar|sse2] [-g]\n");
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t depth = 0;
+    Mancala::Side side = Mancala::Side::A;
+    Mancala::BoardState state = Mancala::BoardState::initial();
+    bool use_game = false;
+    bool golden_mode = false;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "d:s:p:e:k:g")) != -1)
+    {
+        switch (option)
+        {
+            case 'd':
+                depth = static_cast<uint8_t>(atoi(optarg));
+                break;
+
+            case 's':
+                if (optarg[0] == 'A' || optarg[0] == 'a')
+                {
+                    side = Mancala::Side::A;
+                }
+                else if (optarg[0] == 'B' || optarg[0] == 'b')
+                {
+                    side = Mancala::Side::B;
+                }
+                else
+                {
+                    usage();
+                    return 1;
+                }
+                break;
+
+            case 'p':
+                if (!parse_position(optarg, state))
+                {
+                    fprintf(stderr, "Error: a position is 14 pit counts, at most %u marbles.\n",
+                        Mancala::Zobrist::max_marbles);
+                    return 1;
+                }
+                break;
+
+            case 'e':
+                if (strcmp(optarg, "game") == 0)
+                {
+                    use_game = true;
+                }
+                else if (strcmp(optarg, "flat") == 0)
+                {
+                    use_game = false;
+                }
+                else
+                {
+                    usage();
+                    return 1;
+                }
+                break;
+
+            case 'k':
+                if (!Mancala::set_sowing_backend(strcmp(optarg, "scalar") == 0 ?
+                    Mancala::SowingBackend::Scalar : Mancala::SowingBackend::SSE2))
+                {
+                    fprintf(stderr, "Error: sowing kernel %s is not supported.\n", optarg);
+                    return 1;
+                }
+                break;
+
+            case 'g':
+                golden_mode = true;
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (golden_mode)
+    {
+        const uint8_t max_depth = depth == 0 ? default_golden_depth :
+            depth > n_golden ? n_golden : depth;
+        bool passed = true;
+
+        printf("depth        leaves    flat Mnodes/s    game Mnodes/s\n");
+
+        for (uint8_t i = 0; i < max_depth; i++)
+        {
+            double flat_seconds = 0.0;
+            double game_seconds = 0.0;
+
+            const PerftCount flat = perft(Mancala::BoardState::initial(), Mancala::Side::A,
+                golden[i].depth, false, flat_seconds);
+            const PerftCount game = perft(Mancala::BoardState::initial(), Mancala::Side::A,
+                golden[i].depth, true, game_seconds);
+
+            const bool flat_ok = flat.leaves == golden[i].leaves && flat.checksum == golden[i].checksum;
+            const bool game_ok = game.leaves == golden[i].leaves && game.checksum == golden[i].checksum;
+
+            printf("%5u  %12llu  %9.2f %-4s    %9.2f %-4s\n",
+                golden[i].depth, static_cast<unsigned long long>(golden[i].leaves),
+                flat.leaves / flat_seconds / 1e6, flat_ok ? "ok" : "FAIL",
+                game.leaves / game_seconds / 1e6, game_ok ? "ok" : "FAIL");
+
+            passed = passed && flat_ok && game_ok;
+        }
+
+        printf("\n%s\n", passed ? "All counts match." : "Counts differ from the original run_round.");
+
+        return passed ? 0 : 1;
+    }
+
+    if (depth == 0)
+    {
+        depth = 8;
+    }
+
+    printf("%s engine, %s kernel, %c to move\n\n", use_game ? "game" : "flat",
+        Mancala::get_sowing_backend() == Mancala::SowingBackend::SSE2 ? "sse2" : "scalar",
+        side == Mancala::Side::A ? 'A' : 'B');
+    printf("depth        leaves          checksum   seconds   Mnodes/s\n");
+
+    for (uint8_t d = 1; d <= depth; d++)
+    {
+        double seconds = 0.0;
+        const PerftCount count = perft(state, side, d, use_game, seconds);
+
+        printf("%5u  %12llu  %016llx  %8.3f  %9.2f\n", d,
+            static_cast<unsigned long long>(count.leaves),
+            static_cast<unsigned long long>(count.checksum),
+            seconds, count.leaves / seconds / 1e6);
+    }
+
+    return 0;
+}
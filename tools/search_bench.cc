@@ -0,0 +1,72 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Measure how the search scales with threads.
+ *
+ * Searches the opening of Board<4u> to a fixed depth with 1, 2, 4, ...
+ * threads, starting from an empty table each time, and reports the
+ * speedup of each thread count over one thread.
+ *
+ * usage: search_bench [depth] [max threads] [table megabytes]
+ */
+
+#include "board_state.h"
+#include "search.h"
+#include "transposition_table.h"
+
+#include <thread>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv)
+{
+    const uint8_t depth = static_cast<uint8_t>(argc > 1 ? atoi(argv[1]) : 22);
+    unsigned max_threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+    const size_t megabytes = argc > 3 ? atoi(argv[3]) : 256u;
+
+    if (max_threads == 0)
+    {
+        max_threads = 1;
+    }
+
+    if (max_threads > 255)
+    {
+        max_threads = 255;
+    }
+
+    Mancala::TranspositionTable table(megabytes);
+    const Mancala::BoardState opening = Mancala::BoardState::initial();
+
+    printf("depth %u, %zu table entries\n\n", depth, table.size());
+    printf("threads  row  score        nodes   seconds   Mnodes/s  speedup\n");
+
+    double one_thread = 0.0;
+
+    for (unsigned threads = 1; threads <= max_threads;
+        threads = threads < max_threads && threads * 2 > max_threads ? max_threads : threads * 2)
+    {
+        table.clear();
+
+        Mancala::Search search(&table);
+        Mancala::SearchLimits limits;
+        limits.depth = depth;
+        limits.threads = static_cast<uint8_t>(threads);
+
+        const Mancala::SearchResult result = search.think(opening, Mancala::Side::A, limits);
+
+        if (threads == 1)
+        {
+            one_thread = result.seconds;
+        }
+
+        printf("%7u  %3u  %5d  %11llu  %8.3f  %9.2f  %7.2f\n",
+            threads, result.row, result.score,
+            static_cast<unsigned long long>(result.nodes), result.seconds,
+            result.nodes / result.seconds / 1e6, one_thread / result.seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Generate self-play games for opening statistics and training.
+ *
+ * Plays games from the opening with random moves on every core and
+ * streams them to a game file, reporting games/s, moves/s and the write
+ * bandwidth as it goes. Ctrl-C stops a run cleanly, keeping the games
+ * played so far.
+ *
+ * usage: self_play -f file [-g games] [-n marbles] [-t threads] [-s seed]
+ *                  [-i seconds]
+ *
+ *     -g the number of games (default 1000000).
+ *     -n the marbles in each hole at the opening (default 4).
+ *     -t the number of playing threads (default one per core).
+ *     -s the random seed (default 0).
+ *     -i the seconds between progress reports (default 1).
+ */
+
+#include "self_play.h"
+
+#include <thread>
+
+#include <csignal>
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_interrupt(int)
+{
+    interrupted = 1;
+}
+
+/**
+ * Print a progress line.
+ */
+static bool report(const Mancala::SelfPlayStats &stats, void *)
+{
+    const double seconds = stats.seconds > 0.0 ? stats.seconds : 1e-9;
+
+    printf("%12llu games  %8.0f games/s  %7.2f Mmoves/s  %8.2f MB  %7.2f MB/s  %llu dropped\n",
+        static_cast<unsigned long long>(stats.games), stats.games / seconds,
+        stats.moves / seconds / 1e6, stats.bytes / 1e6, stats.bytes / seconds / 1e6,
+        static_cast<unsigned long long>(stats.dropped));
+    fflush(stdout);
+
+    return !interrupted;
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: self_play -f file [-g games] [-n marbles] [-t threads] [-s seed]\n"
+        "                 [-i seconds]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    unsigned long long n_games = 1000000u;
+    unsigned n_marbles = 4;
+    unsigned n_threads = std::thread::hardware_concurrency();
+    unsigned long long seed = 0;
+    unsigned interval = 1;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "f:g:n:t:s:i:")) != -1)
+    {
+        switch (option)
+        {
+            case 'f':
+                path = optarg;
+                break;
+
+            case 'g':
+                n_games = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'n':
+                n_marbles = atoi(optarg);
+                break;
+
+            case 't':
+                n_threads = atoi(optarg);
+                break;
+
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'i':
+                interval = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (n_threads == 0)
+    {
+        n_threads = 1;
+    }
+
+    if (path == NULL || n_marbles == 0 || n_marbles > Mancala::SelfPlay::max_marbles ||
+        n_threads > 255 || interval == 0)
+    {
+        usage();
+        return 1;
+    }
+
+    signal(SIGINT, on_interrupt);
+    signal(SIGTERM, on_interrupt);
+
+    printf("%llu games, %u marbles, %u threads\n\n", n_games, n_marbles, n_threads);
+
+    Mancala::SelfPlay self_play(static_cast<uint8_t>(n_marbles),
+        static_cast<uint8_t>(n_threads), seed);
+
+    if (!self_play.run(path, n_games, report, NULL, interval * 1000u))
+    {
+        if (interrupted)
+        {
+            printf("Stopped.\n");
+            return 0;
+        }
+
+        fprintf(stderr, "Error: could not write to %s.\n", path);
+        return 1;
+    }
+
+    return 0;
+}
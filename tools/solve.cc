@@ -0,0 +1,442 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Solve the opening of a mancala board through a frontier of
+ *        positions d moves deep.
+ *
+ * Each position on the frontier (those first reached in exactly d moves
+ * from the opening) is proven by the exact solver, and its value is
+ * appended to a solution file as soon as it is proven. The values of the
+ * positions before the frontier, and of the opening itself, are then
+ * backed up from the frontier's and appended too. The positions the
+ * solver proves beyond the frontier along the way are not written: the
+ * file holds the opening's tree down to the frontier, not a table of
+ * every position reachable from it.
+ *
+ * A stopped run picks up where it left off when run again with the same
+ * file: proven positions are read back and skipped. Ctrl-C stops a run
+ * cleanly once the positions being solved are done.
+ *
+ * usage: solve -f file [-d plies] [-n marbles] [-t threads] [-m megabytes]
+ *              [-e endgame file] [-i seconds]
+ *
+ *     -d the depth of the frontier (default 6).
+ *     -n the marbles in each hole at the opening (default 4).
+ *     -t the number of solving threads (default 1).
+ *     -m the size of the shared transposition table (default 1024).
+ *     -e an endgame database to end searches at.
+ *     -i the seconds between progress reports and checkpoints (default 10).
+ */
+
+#include "board_state.h"
+#include "endgame_db.h"
+#include "solver.h"
+#include "sowing.h"
+#include "transposition_table.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <csignal>
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+/**
+ * A position to prove.
+ */
+struct Node
+{
+    Mancala::BoardState state;
+    Mancala::Side side;
+    uint16_t ply;
+};
+
+/**
+ * The proven values, by Solver::key.
+ */
+typedef std::unordered_map<uint64_t, int16_t> Values;
+
+/**
+ * Everything the solving threads share.
+ */
+struct Run
+{
+    Run(Mancala::TranspositionTable &_table, const Mancala::EndgameDatabase *_endgame,
+        Mancala::SolutionFile &_file, Values &_values, const std::vector<Node> &_work) :
+        table(_table), endgame(_endgame), file(_file), values(_values), work(_work),
+        next(0), nodes(0), running(0), done(0), failed(false)
+    {
+    }
+
+    Mancala::TranspositionTable &table;
+    const Mancala::EndgameDatabase *endgame;
+    Mancala::SolutionFile &file;
+    Values &values;
+    const std::vector<Node> &work;
+
+    /**
+     * The next position in work to hand out.
+     */
+    std::atomic<size_t> next;
+
+    /**
+     * The positions visited by every thread.
+     */
+    std::atomic<uint64_t> nodes;
+
+    /**
+     * The threads still solving.
+     */
+    std::atomic<unsigned> running;
+
+    /**
+     * Guards file, values, done and failed.
+     */
+    std::mutex lock;
+    size_t done;
+    bool failed;
+};
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_interrupt(int)
+{
+    interrupted = 1;
+}
+
+static void read_record(const Mancala::SolvedPosition &record, void *context)
+{
+    (*static_cast<Values *>(context))[record.key] = record.value;
+}
+
+/**
+ * Solve frontier positions until there are none left.
+ */
+static void solve_work(Run *run)
+{
+    Mancala::Solver solver(run->table, run->endgame);
+    uint64_t counted = 0;
+
+    while (!interrupted)
+    {
+        const size_t i = run->next.fetch_add(1);
+
+        if (i >= run->work.size())
+        {
+            break;
+        }
+
+        const Node &node = run->work[i];
+        const int16_t value = solver.solve(node.state, node.side);
+
+        run->nodes.fetch_add(solver.get_nodes() - counted);
+        counted = solver.get_nodes();
+
+        Mancala::SolvedPosition record;
+        record.key = Mancala::Solver::key(node.state, node.side);
+        record.value = value;
+        record.ply = node.ply;
+        record.reserved = 0;
+
+        std::lock_guard<std::mutex> guard(run->lock);
+        run->values[record.key] = value;
+        run->failed = run->failed || !run->file.append(record);
+        run->done++;
+    }
+
+    run->running.fetch_sub(1);
+}
+
+/**
+ * Back a position's value up from its children's, which are all proven
+ * or before the frontier.
+ */
+static int16_t back_up(const Mancala::BoardState &state, const Mancala::Side side,
+    const std::unordered_map<uint64_t, uint16_t> &plies, Values &values,
+    Mancala::SolutionFile &file)
+{
+    const uint64_t key = Mancala::Solver::key(state, side);
+    const Values::const_iterator found = values.find(key);
+
+    if (found != values.end())
+    {
+        return found->second;
+    }
+
+    const Mancala::Side other = side == Mancala::Side::A ? Mancala::Side::B : Mancala::Side::A;
+    int16_t best = -1000;
+
+    for (uint8_t row : state.legal_moves(side))
+    {
+        Mancala::BoardState child = state;
+        const Mancala::GameState result = Mancala::apply_move(child, side, row);
+
+        const int16_t gain =
+            (static_cast<int16_t>(child.get_home(side)) - state.get_home(side)) -
+            (static_cast<int16_t>(child.get_home(other)) - state.get_home(other));
+
+        int16_t score = gain;
+
+        if (result == (side == Mancala::Side::A ? Mancala::GameState::SideA : Mancala::GameState::SideB))
+        {
+            score += back_up(child, side, plies, values, file);
+        }
+        else if (result != Mancala::GameState::GameOver)
+        {
+            score -= back_up(child, other, plies, values, file);
+        }
+
+        best = score > best ? score : best;
+    }
+
+    Mancala::SolvedPosition record;
+    record.key = key;
+    record.value = best;
+    record.ply = plies.at(key);
+    record.reserved = 0;
+
+    values[key] = best;
+    file.append(record);
+
+    return best;
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "usage: solve -f file [-d plies] [-n marbles] [-t threads] [-m megabytes]\n"
+        "             [-e endgame file] [-i seconds]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    const char *endgame_path = NULL;
+    unsigned frontier_ply = 6;
+    unsigned n_marbles = 4;
+    unsigned n_threads = 1;
+    size_t megabytes = 1024;
+    unsigned interval = 10;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "f:d:n:t:m:e:i:")) != -1)
+    {
+        switch (option)
+        {
+            case 'f':
+                path = optarg;
+                break;
+
+            case 'd':
+                frontier_ply = atoi(optarg);
+                break;
+
+            case 'n':
+                n_marbles = atoi(optarg);
+                break;
+
+            case 't':
+                n_threads = atoi(optarg);
+                break;
+
+            case 'm':
+                megabytes = atoi(optarg);
+                break;
+
+            case 'e':
+                endgame_path = optarg;
+                break;
+
+            case 'i':
+                interval = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    if (path == NULL || n_marbles == 0 || n_marbles > 12u ||
+        n_threads == 0 || interval == 0)
+    {
+        usage();
+        return 1;
+    }
+
+    Mancala::EndgameDatabase endgame;
+
+    if (endgame_path != NULL && !endgame.load(endgame_path))
+    {
+        fprintf(stderr, "Error: could not read %s.\n", endgame_path);
+        return 1;
+    }
+
+    /*
+     * Find every position up to the frontier, each at the fewest moves it
+     * can be reached in. Positions that only differ in their homes are the
+     * same position to the solver.
+     */
+    const Mancala::BoardState opening = Mancala::BoardState::initial(static_cast<uint8_t>(n_marbles));
+
+    std::unordered_map<uint64_t, uint16_t> plies;
+    std::vector<Node> layer(1);
+    layer[0].state = opening;
+    layer[0].side = Mancala::Side::A;
+    layer[0].ply = 0;
+    plies[Mancala::Solver::key(opening, Mancala::Side::A)] = 0;
+
+    for (uint16_t ply = 0; ply < frontier_ply; ply++)
+    {
+        std::vector<Node> next_layer;
+
+        for (const Node &node : layer)
+        {
+            for (uint8_t row : node.state.legal_moves(node.side))
+            {
+                Node child = node;
+                const Mancala::GameState result = Mancala::apply_move(child.state, node.side, row);
+
+                if (result == Mancala::GameState::GameOver)
+                {
+                    continue;
+                }
+
+                child.side = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+                child.ply = static_cast<uint16_t>(ply + 1u);
+
+                if (plies.insert(std::make_pair(Mancala::Solver::key(child.state, child.side), child.ply)).second)
+                {
+                    next_layer.push_back(child);
+                }
+            }
+        }
+
+        layer.swap(next_layer);
+    }
+
+    Values values;
+    Mancala::SolutionFile file;
+
+    if (!file.open(path, read_record, &values))
+    {
+        fprintf(stderr, "Error: could not open %s as a solution file.\n", path);
+        return 1;
+    }
+
+    std::vector<Node> work;
+
+    for (const Node &node : layer)
+    {
+        if (values.find(Mancala::Solver::key(node.state, node.side)) == values.end())
+        {
+            work.push_back(node);
+        }
+    }
+
+    printf("%zu positions before the frontier, %zu on it at ply %u, %zu already proven.\n",
+        plies.size() - layer.size(), layer.size(), frontier_ply, values.size());
+
+    Mancala::TranspositionTable table(megabytes);
+    Run run(table, endgame_path != NULL ? &endgame : NULL, file, values, work);
+
+    signal(SIGINT, on_interrupt);
+    signal(SIGTERM, on_interrupt);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+
+    run.running = n_threads;
+
+    for (unsigned i = 0; i < n_threads; i++)
+    {
+        threads.push_back(std::thread(solve_work, &run));
+    }
+
+    /*
+     * Report progress and checkpoint the file until the work is done.
+     */
+    std::chrono::steady_clock::time_point report = start;
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        bool finished;
+
+        {
+            std::lock_guard<std::mutex> guard(run.lock);
+            finished = run.running.load() == 0;
+
+            if (now - report < std::chrono::seconds(interval) && !finished)
+            {
+                continue;
+            }
+
+            run.failed = run.failed || !file.checkpoint();
+        }
+
+        report = now;
+
+        const double seconds = std::chrono::duration<double>(now - start).count();
+        const size_t done = run.done;
+        const double rate = done / seconds;
+
+        printf("[%7.0fs] %zu/%zu frontier positions proven, %.2f positions/s, %.2f Mnodes/s",
+            seconds, done, work.size(), rate, run.nodes.load() / seconds / 1e6);
+
+        if (rate > 0.0 && done < work.size())
+        {
+            printf(", about %.0fs left", (work.size() - done) / rate);
+        }
+
+        printf("\n");
+        fflush(stdout);
+
+        if (finished)
+        {
+            break;
+        }
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    if (run.failed || !file.checkpoint())
+    {
+        fprintf(stderr, "Error: could not write to %s.\n", path);
+        return 1;
+    }
+
+    if (run.done < work.size())
+    {
+        printf("Stopped. Run again with the same file to carry on.\n");
+        return 0;
+    }
+
+    const int16_t value = back_up(opening, Mancala::Side::A, plies, values, file);
+
+    if (!file.checkpoint())
+    {
+        fprintf(stderr, "Error: could not write to %s.\n", path);
+        return 1;
+    }
+
+    printf("Proven: A, moving first, finishes %+d (%s) with %u marbles a hole.\n",
+        value, value > 0 ? "a win" : value < 0 ? "a loss" : "a tie, won by B", n_marbles);
+
+    return 0;
+}
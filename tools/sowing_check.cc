@@ -0,0 +1,414 @@
+/**
+ * @author Sargis S Yonan
+ * @date 17 October 2026
+ *
+ * @brief Check every way of playing a move against a marble by marble
+ *        reference.
+ *
+ * Random positions, with counts well above the opening's, get a random
+ * side and row (empty holes included), and the move is played by:
+ *
+ *     a reference loop that sows one marble at a time, as run_round
+ *     first did, and then by
+ *     apply_move on the scalar kernel,
+ *     apply_move on the SSE2 kernel, when the CPU has it,
+ *     make_move, then unmake_move back to the position, and
+ *     BoardBatch::apply_moves, a batch at a time.
+ *
+ * Every state and result must match the reference exactly. Then random
+ * games are played from the opening with make_move and unwound with
+ * unmake_move, checking every earlier position is restored.
+ *
+ * usage: sowing_check [-n positions] [-g games] [-s seed]
+ *
+ *     -n the number of random positions (default 1000000).
+ *     -g the number of games to unwind (default 20000).
+ *     -s the random seed (default 0).
+ */
+
+#include "batch.h"
+#include "board_state.h"
+#include "random.h"
+#include "sowing.h"
+
+#include <vector>
+
+#include <cstdbool>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+/**
+ * The most marbles a hole starts with in a random position.
+ */
+static const uint8_t max_hole_marbles = 24u;
+
+/**
+ * The most marbles a home starts with in a random position, leaving room
+ * for every hole to be swept into it.
+ */
+static const uint8_t max_home_marbles = 48u;
+
+/**
+ * The boards played at once by BoardBatch.
+ */
+static const size_t batch_size = 4096u;
+
+/**
+ * One random move and what the reference made of it.
+ */
+struct Case
+{
+    Mancala::BoardState before;
+    Mancala::Side side;
+    uint8_t row;
+    Mancala::BoardState after;
+    Mancala::GameState result;
+};
+
+/**
+ * Play a move one marble at a time.
+ */
+static Mancala::GameState reference_move(Mancala::BoardState &state,
+    const Mancala::Side side, const uint8_t row)
+{
+    using Mancala::BoardState;
+
+    if (row >= BoardState::n_rows || state.get_hole(side, row) == 0)
+    {
+        return Mancala::GameState::EmptyHoleError;
+    }
+
+    const Mancala::Side other = side == Mancala::Side::A ? Mancala::Side::B : Mancala::Side::A;
+    uint8_t pit = BoardState::pit(side, row);
+    uint8_t marbles = state.pits[pit];
+
+    state.pits[pit] = 0;
+
+    while (marbles > 0)
+    {
+        pit = static_cast<uint8_t>((pit + 1u) % BoardState::n_pits);
+
+        if (pit == BoardState::home(other))
+        {
+            continue;
+        }
+
+        state.pits[pit]++;
+        marbles--;
+    }
+
+    const bool own_hole = pit != BoardState::home(side) && pit != BoardState::home(other) &&
+        (side == Mancala::Side::A) == (pit < BoardState::home(Mancala::Side::A));
+
+    if (own_hole && state.pits[pit] == 1u)
+    {
+        const uint8_t across = BoardState::opposite(pit);
+
+        state.pits[BoardState::home(side)] += state.pits[across] + 1u;
+        state.pits[across] = 0;
+        state.pits[pit] = 0;
+    }
+
+    uint8_t a_left = 0;
+    uint8_t b_left = 0;
+
+    for (uint8_t r = 0; r < BoardState::n_rows; r++)
+    {
+        a_left |= state.get_hole(Mancala::Side::A, r);
+        b_left |= state.get_hole(Mancala::Side::B, r);
+    }
+
+    if (a_left == 0 || b_left == 0)
+    {
+        for (uint8_t r = 0; r < BoardState::n_rows; r++)
+        {
+            for (uint8_t s = 0; s < 2; s++)
+            {
+                const Mancala::Side owner = static_cast<Mancala::Side>(s);
+                uint8_t &hole = state.pits[BoardState::pit(owner, r)];
+
+                state.pits[BoardState::home(owner)] += hole;
+                hole = 0;
+            }
+        }
+
+        return Mancala::GameState::GameOver;
+    }
+
+    return (pit == BoardState::home(side)) == (side == Mancala::Side::A) ?
+        Mancala::GameState::SideA : Mancala::GameState::SideB;
+}
+
+/**
+ * Make a random position and move, and play it on the reference.
+ */
+static void random_case(Mancala::Random &random, Case &test)
+{
+    using Mancala::BoardState;
+
+    memset(&test.before, 0, sizeof(test.before));
+
+    for (uint8_t pit = 0; pit < BoardState::n_pits; pit++)
+    {
+        const bool home = pit == BoardState::home(Mancala::Side::A) ||
+            pit == BoardState::home(Mancala::Side::B);
+        const uint64_t draw = random.next() >> 32;
+
+        /*
+         * Empty holes a third of the time, for captures and game overs.
+         */
+        test.before.pits[pit] = home ? static_cast<uint8_t>(draw % (max_home_marbles + 1u)) :
+            draw % 3u == 0 ? 0u : static_cast<uint8_t>((draw >> 8) % (max_hole_marbles + 1u));
+    }
+
+    test.side = static_cast<Mancala::Side>(random.next() >> 63);
+    test.row = static_cast<uint8_t>((random.next() >> 32) % BoardState::n_rows);
+    test.after = test.before;
+    test.result = reference_move(test.after, test.side, test.row);
+}
+
+/**
+ * Report a move that differs from the reference.
+ */
+static void report(const char *path, const Case &test, const Mancala::BoardState &state,
+    const Mancala::GameState result)
+{
+    fprintf(stderr, "%s differs: %c row %u from", path,
+        test.side == Mancala::Side::A ? 'A' : 'B', test.row);
+
+    for (uint8_t pit = 0; pit < Mancala::BoardState::n_pits; pit++)
+    {
+        fprintf(stderr, "%c%u", pit == 0 ? ' ' : ',', test.before.pits[pit]);
+    }
+
+    fprintf(stderr, "\n    reference %d:", test.result);
+
+    for (uint8_t pit = 0; pit < Mancala::BoardState::n_pits; pit++)
+    {
+        fprintf(stderr, " %u", test.after.pits[pit]);
+    }
+
+    fprintf(stderr, "\n    %s %d:", path, result);
+
+    for (uint8_t pit = 0; pit < Mancala::BoardState::n_pits; pit++)
+    {
+        fprintf(stderr, " %u", state.pits[pit]);
+    }
+
+    fprintf(stderr, "\n");
+}
+
+/**
+ * Play a move with apply_move on a kernel.
+ */
+static bool check_kernel(const char *path, const Case &test)
+{
+    Mancala::BoardState state = test.before;
+    const Mancala::GameState result = Mancala::apply_move(state, test.side, test.row);
+
+    if (state != test.after || result != test.result)
+    {
+        report(path, test, state, result);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Play a move with make_move, then take it back.
+ */
+static bool check_undo(const Case &test)
+{
+    Mancala::BoardState state = test.before;
+    Mancala::MoveUndo undo;
+    const Mancala::GameState result = Mancala::make_move(state, test.side, test.row, undo);
+
+    if (state != test.after || result != test.result)
+    {
+        report("make_move", test, state, result);
+        return false;
+    }
+
+    Mancala::unmake_move(state, undo);
+
+    if (state != test.before)
+    {
+        report("unmake_move", test, state, result);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Play a batch of moves with BoardBatch.
+ */
+static uint64_t check_batch(const std::vector<Case> &tests)
+{
+    Mancala::BoardBatch batch(tests.size());
+    std::vector<Mancala::Side> sides(tests.size());
+    std::vector<uint8_t> rows(tests.size());
+    std::vector<Mancala::GameState> results(tests.size());
+
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        batch.set(i, tests[i].before);
+        sides[i] = tests[i].side;
+        rows[i] = tests[i].row;
+    }
+
+    batch.apply_moves(sides.data(), rows.data(), results.data());
+
+    uint64_t failures = 0;
+
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        const Mancala::BoardState state = batch.get(i);
+
+        if (state != tests[i].after || results[i] != tests[i].result)
+        {
+            report("BoardBatch", tests[i], state, results[i]);
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * Play a random game with make_move, then unwind it to the opening.
+ */
+static bool unwind_game(Mancala::Random &random, const uint8_t n_marbles)
+{
+    std::vector<Mancala::BoardState> positions;
+    std::vector<Mancala::MoveUndo> undos;
+
+    Mancala::BoardState state = Mancala::BoardState::initial(n_marbles);
+    Mancala::Side side = Mancala::Side::A;
+    Mancala::GameState result;
+
+    do
+    {
+        Mancala::MoveUndo undo;
+
+        positions.push_back(state);
+        result = Mancala::make_move(state, side, random.pick(state.legal_moves(side)), undo);
+        undos.push_back(undo);
+        side = result == Mancala::GameState::SideA ? Mancala::Side::A : Mancala::Side::B;
+    } while (result != Mancala::GameState::GameOver);
+
+    while (!undos.empty())
+    {
+        Mancala::unmake_move(state, undos.back());
+
+        if (state != positions.back())
+        {
+            fprintf(stderr, "unmake_move differs %zu moves into a game of %u marbles a hole.\n",
+                positions.size() - 1u, n_marbles);
+            return false;
+        }
+
+        undos.pop_back();
+        positions.pop_back();
+    }
+
+    return true;
+}
+
+/**
+ * Print the usage.
+ */
+static void usage()
+{
+    fprintf(stderr, "usage: sowing_check [-n positions] [-g games] [-s seed]\n");
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long long n_positions = 1000000ull;
+    unsigned long long n_games = 20000ull;
+    unsigned long long seed = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:g:s:")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                n_positions = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'g':
+                n_games = strtoull(optarg, NULL, 10);
+                break;
+
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+
+            default:
+                usage();
+                return 1;
+        }
+    }
+
+    const bool has_sse2 = Mancala::set_sowing_backend(Mancala::SowingBackend::SSE2);
+
+    printf("%llu positions, %llu games, kernels: scalar%s\n", n_positions, n_games,
+        has_sse2 ? ", sse2" : "");
+
+    Mancala::Random random(seed);
+    std::vector<Case> tests;
+    uint64_t failures = 0;
+
+    tests.reserve(batch_size);
+
+    for (unsigned long long i = 0; i < n_positions && failures < 10u; i++)
+    {
+        Case test;
+        random_case(random, test);
+
+        Mancala::set_sowing_backend(Mancala::SowingBackend::Scalar);
+        failures += !check_kernel("scalar", test);
+        failures += !check_undo(test);
+
+        if (has_sse2)
+        {
+            Mancala::set_sowing_backend(Mancala::SowingBackend::SSE2);
+            failures += !check_kernel("sse2", test);
+            failures += !check_undo(test);
+        }
+
+        tests.push_back(test);
+
+        if (tests.size() == batch_size || i + 1u == n_positions)
+        {
+            failures += check_batch(tests);
+            tests.clear();
+        }
+    }
+
+    /*
+     * Unwind games at every opening count a record or endgame database
+     * might see.
+     */
+    for (unsigned long long i = 0; i < n_games && failures < 10u; i++)
+    {
+        failures += !unwind_game(random, static_cast<uint8_t>(1u + i % 12u));
+    }
+
+    if (failures != 0)
+    {
+        printf("\n%llu moves differ.\n", static_cast<unsigned long long>(failures));
+        return 1;
+    }
+
+    printf("\nEvery move matches the reference.\n");
+
+    return 0;
+}